@@ -0,0 +1,74 @@
+// Varredura de PCBs como a do escalonador: cria BENCH_PCBS processos pelo
+// pool e lê state, priority_level e quantum_remaining de todos via
+// all_processes, BENCH_PASSES vezes. Mede o efeito da separação quente/fria
+// do PCB (make bench-pcb; ver Makefile).
+#include "../src/pcb.h"
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#ifndef BENCH_PCBS
+#define BENCH_PCBS 100000
+#endif
+#ifndef BENCH_PASSES
+#define BENCH_PASSES 200
+#endif
+#ifndef BENCH_RUNS
+#define BENCH_RUNS 3
+#endif
+
+static double elapsed(struct timespec start, struct timespec end) {
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+int main(void) {
+    // create_pcb anuncia cada processo: a saída vai para /dev/null
+    fflush(stdout);
+    int saved_stdout = dup(STDOUT_FILENO);
+    int null_fd = open("/dev/null", O_WRONLY);
+    if (saved_stdout >= 0 && null_fd >= 0) dup2(null_fd, STDOUT_FILENO);
+
+    int created = 0;
+    for (int i = 0; i < BENCH_PCBS; i++) {
+        PCB* pcb = create_pcb();
+        if (!pcb) break;
+        pcb->state = i % 3 == 0 ? READY : RUNNING;
+        pcb->priority_level = i % 3;
+        created++;
+    }
+
+    fflush(stdout);
+    if (saved_stdout >= 0 && null_fd >= 0) {
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+        close(null_fd);
+    }
+
+    printf("[Bench] %d PCBs (sizeof(PCB) = %zu bytes), %d passadas\n",
+           created, sizeof(PCB), BENCH_PASSES);
+
+    for (int run = 0; run < BENCH_RUNS; run++) {
+        struct timespec start, end;
+        long checksum = 0;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        for (int pass = 0; pass < BENCH_PASSES; pass++) {
+            for (int i = 0; i < total_processes; i++) {
+                PCB* pcb = all_processes[i];
+                if (pcb->state == READY) checksum += pcb->priority_level;
+                checksum += pcb->quantum_remaining;
+            }
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+
+        double seconds = elapsed(start, end);
+        printf("[Bench] Execução %d: %.1f M PCB/s (%.3f s, checksum %ld)\n", run + 1,
+               (double)total_processes * BENCH_PASSES / seconds / 1e6, seconds, checksum);
+    }
+
+    for (int i = 0; i < total_processes; i++) {
+        free_pcb(all_processes[i]);
+    }
+    destroy_pcb_pool();
+    return 0;
+}
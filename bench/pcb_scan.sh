@@ -0,0 +1,25 @@
+#!/bin/sh
+# Varredura de PCBs antes e depois da separação quente/fria do PCB.
+# Compila bench/pcb_scan.c (make bench-pcb) contra o src/ atual e contra o
+# src/ do commit anterior à separação, cada um num worktree temporário.
+# Uso: bench/pcb_scan.sh [commit-antes]
+set -e
+
+ROOT=$(git rev-parse --show-toplevel)
+cd "$ROOT"
+
+BEFORE=${1:-$(git log --format=%H -1 --grep="Split PCB into hot and cold")^}
+WORK=$(mktemp -d)
+trap 'git worktree remove --force "$WORK/before" >/dev/null 2>&1; rm -rf "$WORK"' EXIT
+
+# Sem -Werror: o src/ antigo tem avisos que só aparecem com -O2
+FLAGS="-Wall -Wextra -O2"
+
+git worktree add -q --detach "$WORK/before" "$BEFORE"
+cp -r bench Makefile "$WORK/before/"
+
+echo "═══ Antes ($(git rev-parse --short "$BEFORE")) ═══"
+make -s -C "$WORK/before" bench-pcb BUILD="$WORK/build-before" CXXFLAGS="$FLAGS" | grep "^\[Bench\]"
+
+echo "═══ Depois (árvore atual) ═══"
+make -s bench-pcb BUILD="$WORK/build-after" CXXFLAGS="$FLAGS" | grep "^\[Bench\]"
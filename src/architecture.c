@@ -7,11 +7,11 @@
 #include "pcb.h"
 #include "pipeline.h"
 #include "cache.h"
-extern CacheEntry cache[];
+#include "cache_hierarchy.h"
+#include "virtual_memory.h"
 
 void init_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc, 
                      peripherals* peripherals, architecture_state* state) {
-   (void)memory_disc;    
    (void)peripherals;     
    // printf("\n[Init] Iniciando arquitetura");
    // printf("\n[Init] Verificação inicial:");
@@ -28,6 +28,12 @@ void init_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
    }
 
    init_cpu(cpu, memory_ram);
+   cache_attach_memory(memory_ram->vector, memory_ram->size);
+
+   // Disco como swap da memória virtual (sem ele, falta sem frame livre falha)
+   if (memory_disc && init_disc(memory_disc, SWAP_SLOTS, PAGE_SIZE)) {
+       attach_swap_disc(memory_disc);
+   }
 
    // printf("\n[Init] Verificação após init_cpu:");
    // printf("\n - RAM: %p", (void*)memory_ram);
@@ -76,6 +82,13 @@ void init_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
    state->blocked_processes = 0;
    state->context_switches = 0;
    state->avg_turnaround = 0;
+   state->migrations = 0;
+   state->affinity_hits = 0;
+   state->affinity_stall_cycles = 0;
+   state->switch_cost_cycles = 0;
+   state->registers_saved = 0;
+   state->lazy_restores = 0;
+   state->memory_stall_cycles = 0;
 
    pthread_mutex_init(&state->global_mutex, NULL);
 
@@ -91,8 +104,8 @@ void update_system_metrics(architecture_state* state) {
     int completed = 0;
     
     for (int i = 0; i < total_processes; i++) {
-        if (all_processes[i] && all_processes[i]->was_completed) {
-            total_turnaround += all_processes[i]->cycles_executed;
+        if (process_records[i].recorded && process_records[i].was_completed) {
+            total_turnaround += process_records[i].cycles_executed;
             completed++;
         }
     }
@@ -132,6 +145,17 @@ void free_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
                      int cycle_count) {
     printf("\n\n═══════════ Métricas Finais ═══════════");
 
+    // Quem não terminou ainda tem PCB: registra para os relatórios abaixo
+    for (int i = 0; i < total_processes; i++) {
+        PCB* process = all_processes[i];
+        if (!process) continue;
+        record_process(process);
+        // Ainda na fila: a espera corrente só seria somada no próximo despacho
+        if (process->state == READY) {
+            process_records[i].waiting_time += cycle_count - process->ready_since;
+        }
+    }
+
     if (state && state->process_manager && state->process_manager->policy) {
         switch(state->process_manager->policy->type) {
             case POLICY_CACHE_AWARE:
@@ -142,22 +166,22 @@ void free_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
 
                     printf("\n\n[Desempenho por Processo]");
                     for(int i = 0; i < total_processes; i++) {
-                        if (all_processes[i]) {
-                            int idx = all_processes[i]->base_address % CACHE_SIZE;
-                            total_hits += cache[idx].hits;
-                            total_misses += cache[idx].misses;
-                            float hit_ratio = (cache[idx].hits + cache[idx].misses) > 0 ?
-                                (float)cache[idx].hits / (cache[idx].hits + cache[idx].misses) * 100 : 0.0;
+                        if (process_records[i].recorded) {
+                            int hits = process_records[i].cache_hits;
+                            int misses = process_records[i].cache_misses;
+                            float penalty = average_miss_penalty();
+                            total_hits += hits;
+                            total_misses += misses;
+                            float hit_ratio = (hits + misses) > 0 ?
+                                (float)hits / (hits + misses) * 100 : 0.0;
 
                             printf("\n┌── P%d", i);
-                            printf("\n├── Cache Hits: %d", cache[idx].hits);
-                            printf("\n├── Cache Misses: %d", cache[idx].misses);
+                            printf("\n├── Cache Hits: %d", hits);
+                            printf("\n├── Cache Misses: %d", misses);
                             printf("\n├── Hit Ratio: %.1f%%", hit_ratio);
-                            printf("\n├── Acessos Totais: %d", cache[idx].hits + cache[idx].misses);
-                            printf("\n├── Eficiência: %.1f%%",
-                                (hit_ratio * cache[idx].hits * 100) /
-                                (hit_ratio * cache[idx].hits + MISS_PENALTY * cache[idx].misses));
-                            printf("\n└── Prefetch Hits: %d", cache[idx].prefetch_hits);
+                            printf("\n├── Acessos Totais: %d", hits + misses);
+                            printf("\n└── Eficiência: %.1f%%", (hits + misses) > 0 ?
+                                (hits * 100) / (hits + penalty * misses) : 0.0f);
                         }
                     }
 
@@ -169,50 +193,66 @@ void free_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
                     printf("\n├── Total Misses: %ld", total_misses);
                     printf("\n├── Hit Ratio Médio: %.1f%%", avg_hit_ratio);
                     printf("\n├── Penalidade Média: %.1f ciclos/processo",
-                        (float)(total_misses * MISS_PENALTY) / total_processes);
+                        (float)hierarchy_miss_cycles() / total_processes);
 
                     float cache_throughput = (total_hits + total_misses) / (float)cycle_count;
                     printf("\n├── Cache Throughput: %.2f acessos/ciclo", cache_throughput);
 
                     float total_efficiency = 0;
                     for(int i = 0; i < total_processes; i++) {
-                        if (all_processes[i]) {
-                            int idx = all_processes[i]->base_address % CACHE_SIZE;
-                            float process_ratio = (float)cache[idx].hits /
-                                               (cache[idx].hits + cache[idx].misses);
-                            total_efficiency += process_ratio;
+                        if (process_records[i].recorded) {
+                            int accesses = process_records[i].cache_hits +
+                                           process_records[i].cache_misses;
+                            if (accesses > 0) {
+                                total_efficiency += (float)process_records[i].cache_hits / accesses;
+                            }
                         }
                     }
                     printf("\n└── Eficiência Média: %.1f%%",
                           (total_efficiency / total_processes) * 100);
 
-                    printf("\n\n[Análise de Regiões]");
-                    for(int i = 0; i < CACHE_SIZE; i++) {
-                        if(cache[i].hits + cache[i].misses > 0) {
-                            printf("\n┌── Endereço %d", i);
-                            printf("\n├── Acessos: %d", cache[i].hits + cache[i].misses);
-                            printf("\n├── Hits/Misses: %d/%d", cache[i].hits, cache[i].misses);
-                            printf("\n├── Hit Ratio: %.1f%%",
-                                  (float)cache[i].hits/(cache[i].hits + cache[i].misses) * 100);
-                            printf("\n└── Prefetch Accuracy: %.1f%%", cache[i].prefetch_accuracy * 100);
+                    // Análise por linha só existe com o sidecar de diagnóstico
+                    if (cache_line_diagnostics(0, 0)) {
+                        printf("\n\n[Análise de Linhas]");
+                        for(int core = 0; core < NUM_CORES; core++) {
+                            for(int i = 0; i < CACHE_SIZE; i++) {
+                                line_diagnostics* line = cache_line_diagnostics(core, i);
+                                if(line->hits + line->misses > 0) {
+                                    printf("\n┌── Core %d, conjunto %d, via %d", core, i / CACHE_WAYS, i % CACHE_WAYS);
+                                    printf("\n├── Acessos: %d", line->hits + line->misses);
+                                    printf("\n├── Hits/Misses: %d/%d", line->hits, line->misses);
+                                    printf("\n├── Hit Ratio: %.1f%%",
+                                          (float)line->hits/(line->hits + line->misses) * 100);
+                                    printf("\n└── Prefetch Accuracy: %.1f%%",
+                                          line->hits > 0 ? (float)line->prefetch_hits * 100 / line->hits : 0.0f);
+                                }
+                            }
                         }
                     }
 
+                    print_gang_cache_delta();
+
                     if (cache_enabled) {
                         print_cache_statistics();
-                        print_instruction_patterns();
                     }
                 }
                 break;
 
             case POLICY_SJF:
-                printf("\n[Métricas SJF]");
+            case POLICY_SRTF:
+                printf("\n[Métricas %s]",
+                       state->process_manager->policy->type == POLICY_SRTF ? "SRTF" : "SJF");
                 for(int i = 0; i < total_processes; i++) {
-                    if (all_processes[i]) {
+                    if (process_records[i].recorded) {
                         printf("\n┌── P%d", i);
-                        printf("\n├── Tamanho: %zu bytes", all_processes[i]->program_size);
+                        printf("\n├── Tamanho: %zu bytes", process_records[i].program_size);
+                        printf("\n├── Instruções estimadas: %d (executadas: %d)",
+                               process_records[i].estimated_instructions,
+                               process_records[i].total_instructions);
+                        printf("\n├── Burst médio estimado: %.2f",
+                               process_records[i].burst_estimate);
                         printf("\n└── Tempo de Execução: %d ciclos",
-                               all_processes[i]->cycles_executed);
+                               process_records[i].cycles_executed);
                     }
                 }
                 break;
@@ -220,31 +260,101 @@ void free_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
             case POLICY_LOTTERY:
                 printf("\n[Métricas Lottery]");
 
-                float avg_waiting = 0, avg_response = 0, avg_turnaround = 0;
-                int completed = 0;
+                for(int i = 0; i < total_processes; i++) {
+                    if (process_records[i].recorded) {
+                        printf("\n┌── P%d", i);
+                        printf("\n├── Tickets: %d", process_records[i].tickets);
+                        printf("\n└── Sorteios vencidos: %d", process_records[i].lottery_selections);
+                    }
+                }
+                break;
 
+            case POLICY_MLFQ:
+                // Comparação com RR: mesma carga com a política 1; as duas
+                // execuções imprimem os mesmos [Tempos Médios] medidos
+                printf("\n[Métricas MLFQ]");
                 for(int i = 0; i < total_processes; i++) {
-                    if (all_processes[i]) {
-                        avg_waiting += all_processes[i]->waiting_time;
-                        avg_response += all_processes[i]->response_time;
-                        avg_turnaround += all_processes[i]->turnaround_time;
-                        completed++;
+                    process_record* process = &process_records[i];
+                    if (!process->recorded) continue;
+
+                    printf("\n┌── P%d", process->pid);
+                    printf("\n└── Nível final: %d", process->priority_level);
+                }
+                break;
+
+            case POLICY_CFS:
+                printf("\n[Métricas CFS]");
+                {
+                    double sum = 0, sum_sq = 0;
+                    int counted = 0;
+
+                    for(int i = 0; i < total_processes; i++) {
+                        process_record* process = &process_records[i];
+                        if (!process->recorded) continue;
+
+                        // Fatia de CPU enquanto esteve no sistema: instruções
+                        // por ciclo entre a chegada e o término (ou o fim)
+                        int end = process->was_completed ? process->completion_time : cycle_count;
+                        int present = end - process->arrival_time;
+                        double share = present > 0 ? (double)process->total_instructions / present : 0.0;
+
+                        printf("\n┌── P%d", process->pid);
+                        printf("\n├── vruntime: %lu", process->vruntime);
+                        printf("\n├── Instruções: %d", process->total_instructions);
+                        printf("\n└── Fatia de CPU: %.3f instruções/ciclo em %d ciclos", share, present);
+
+                        if (present <= 0) continue;
+                        sum += share;
+                        sum_sq += share * share;
+                        counted++;
+                    }
+
+                    // Índice de Jain sobre as fatias (pesos iguais): 1.0 =
+                    // todos receberam a mesma taxa de CPU enquanto presentes
+                    if (counted > 0 && sum_sq > 0) {
+                        printf("\n\n[Justiça]");
+                        printf("\n└── Índice de Jain: %.3f", (sum * sum) / (counted * sum_sq));
                     }
                 }
+                break;
+
+            case POLICY_EDF:
+                printf("\n[Métricas EDF]");
+                {
+                    int misses = count_deadline_misses(cycle_count);
+                    int admitted = 0;
 
-                printf("\n[Tempos Médios]");
-                printf("\n┌── Espera: %.2f ciclos", avg_waiting/completed);
-                printf("\n├── Resposta: %.2f ciclos", avg_response/completed);
-                printf("\n└── Turnaround: %.2f ciclos", avg_turnaround/completed);
+                    for(int i = 0; i < total_processes; i++) {
+                        process_record* process = &process_records[i];
+                        if (!process->recorded || !process->admitted) continue;
+                        admitted++;
+
+                        printf("\n┌── P%d", process->pid);
+                        printf("\n├── Prazo: ciclo %d", process->absolute_deadline);
+                        if (process->was_completed) {
+                            printf("\n├── Término: ciclo %d", process->completion_time);
+                        } else {
+                            printf("\n├── Término: não concluído");
+                        }
+                        printf("\n└── Prazo cumprido: %s", process->deadline_missed ? "Não" : "Sim");
+                    }
+
+                    printf("\n\n[Prazos]");
+                    printf("\n┌── Admitidos: %d", admitted);
+                    printf("\n├── Recusados: %d", state->process_manager->rejected_processes);
+                    printf("\n├── Perdas de prazo: %d", misses);
+                    printf("\n└── Taxa de perda: %.1f%%",
+                           admitted > 0 ? (float)misses * 100 / admitted : 0.0f);
+                }
                 break;
 
             case POLICY_RR:
                 printf("\n[Métricas Round Robin]");
                 for(int i = 0; i < total_processes; i++) {
-                    if (all_processes[i]) {
+                    if (process_records[i].recorded) {
                         printf("\n┌── P%d", i);
                         printf("\n└── Preempções: %d",
-                               all_processes[i]->cycles_executed / DEFAULT_QUANTUM);
+                               process_records[i].cycles_executed / DEFAULT_QUANTUM);
                     }
                 }
                 break;
@@ -257,6 +367,65 @@ void free_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
     printf("\n├── IPC Médio: %.2f", (float)state->total_instructions / cycle_count);
     printf("\n└── Trocas de Contexto: %d", state->context_switches);
 
+    printf("\n\n[Tempos por Processo] (chegada / resposta / espera / turnaround)");
+    for (int i = 0; i < total_processes; i++) {
+        process_record* process = &process_records[i];
+        if (!process->recorded) continue;
+        printf("\n%s── P%d: %d / %d / %d / %d", i == total_processes - 1 ? "└" : "├",
+               process->pid, process->arrival_time, process->response_time,
+               process->waiting_time, process->turnaround_time);
+    }
+
+    // Medidos da mesma forma para toda política. Quem não terminou entra
+    // com o tempo até o fim da execução (limite inferior do seu turnaround)
+    {
+        float avg_response = 0, avg_waiting = 0, avg_turnaround = 0;
+        int counted = 0, unfinished = 0;
+
+        for (int i = 0; i < total_processes; i++) {
+            process_record* process = &process_records[i];
+            if (!process->recorded) continue;
+
+            int elapsed = cycle_count - process->arrival_time;
+            avg_response += process->response_time >= 0 ? process->response_time : elapsed;
+            avg_waiting += process->waiting_time;
+            avg_turnaround += process->was_completed ? process->turnaround_time : elapsed;
+            if (!process->was_completed) unfinished++;
+            counted++;
+        }
+
+        if (counted > 0) {
+            printf("\n\n[Tempos Médios] (%d processos, %d não concluídos)", counted, unfinished);
+            printf("\n┌── Resposta: %.2f ciclos", avg_response / counted);
+            printf("\n├── Espera: %.2f ciclos", avg_waiting / counted);
+            printf("\n└── Turnaround: %.2f ciclos", avg_turnaround / counted);
+        }
+    }
+
+    printf("\n\n[Quantum] (%s)", ADAPTIVE_QUANTUM ? "adaptativo" : "fixo");
+    printf("\n┌── Inicial: %d", DEFAULT_QUANTUM);
+    printf("\n├── Final: %d", state->process_manager->quantum_size);
+    printf("\n└── Ajustes: %d", state->process_manager->tuner.adjustments);
+
+    printf("\n\n[Afinidade de Core] (%s)", AFFINITY_ENABLED ? "preferindo último core" : "oblívio");
+    printf("\n┌── Retornos ao mesmo core: %d", state->affinity_hits);
+    printf("\n├── Migrações: %d", state->migrations);
+    printf("\n└── Ciclos de stall por afinidade: %d%s", state->affinity_stall_cycles,
+           cache_enabled ? " (misses frios cobrados pela L1/TLB)" : " (estimados, sem cache)");
+
+    printf("\n\n[Custo de Troca de Contexto] (%s)",
+           CONTEXT_SWITCH_COST_ENABLED ? "modelado" : "gratuito");
+    printf("\n┌── Ciclos de drenagem/save/restore: %d", state->switch_cost_cycles);
+    printf("\n├── Registradores salvos: %d", state->registers_saved);
+    printf("\n├── Restores preguiçosos: %d", state->lazy_restores);
+    printf("\n└── Custo total (com afinidade estimada): %d ciclos",
+           state->switch_cost_cycles + state->affinity_stall_cycles);
+
+    printf("\n\n[Stall de Memória] (%s)", CACHE_STALLS_ENABLED ? "cobrado" : "só contabilizado");
+    printf("\n└── Ciclos de stall %s: %d",
+           cache_enabled ? "por misses de L1" : "por acessos à memória (sem cache)",
+           state->memory_stall_cycles);
+
     printf("\n\n[Utilização do Sistema]");
     printf("\n└── Ocupação dos Cores: %.1f%%",
            (float)(state->total_instructions * 100) / (cycle_count * NUM_CORES));
@@ -276,6 +445,7 @@ void free_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
     cleanup_cpu_threads(cpu);
 
     if (memory_ram) {
+        free_ram_blocks(memory_ram);
         free(memory_ram->vector);
         free(memory_ram);
     }
@@ -291,6 +461,7 @@ void free_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
     }
 
     if (memory_disc) {
+        free_disc(memory_disc);
         free(memory_disc);
     }
 
@@ -307,6 +478,7 @@ void free_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc,
             free_pcb(all_processes[i]);
         }
     }
+    destroy_pcb_pool();
 
     printf("[Sistema] Execução finalizada\n");
 }
\ No newline at end of file
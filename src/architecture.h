@@ -12,7 +12,25 @@
 #include "architecture_state.h"
 
 #define DEFAULT_QUANTUM 5
-#define MAX_CYCLES 40
+#ifndef MAX_CYCLES
+#define MAX_CYCLES 1000     // Teto de segurança; o loop para quando a carga termina
+#endif
+#ifndef CYCLE_DELAY_US
+#define CYCLE_DELAY_US 50000  // Pausa por ciclo para acompanhar a saída
+#endif
+
+// Ajuste adaptativo do quantum
+#ifndef ADAPTIVE_QUANTUM
+#define ADAPTIVE_QUANTUM true          // false = quantum fixo em DEFAULT_QUANTUM
+#endif
+#ifndef QUANTUM_OVERHEAD_BUDGET
+#define QUANTUM_OVERHEAD_BUDGET 0.10f  // Fração máxima de ciclos gastos em trocas
+#endif
+#define QUANTUM_TUNE_INTERVAL 5        // Ciclos por janela de observação
+#define QUANTUM_SWITCH_COST 2          // Custo por troca se o modelo de custo estiver desligado
+#define QUANTUM_RESPONSE_TARGET 10     // Resposta média aceitável (ciclos)
+#define QUANTUM_MIN 2
+#define QUANTUM_MAX 32
 
 // Funções principais 
 void init_architecture(cpu* cpu, ram* memory_ram, disc* memory_disc, 
@@ -33,6 +33,19 @@ typedef struct architecture_state {
     int context_switches;
     float avg_turnaround;
 
+    // Afinidade de core
+    int migrations;
+    int affinity_hits;
+    int affinity_stall_cycles;
+
+    // Custo das trocas de contexto
+    int switch_cost_cycles;  // Drenagem + save/restore de registradores
+    int registers_saved;     // Registradores sujos gravados no PCB
+    int lazy_restores;       // Restores dispensados (contexto ainda no core)
+
+    // Hierarquia de memória
+    int memory_stall_cycles; // Stall cobrado pelos misses de L1
+
     scheduling_metrics metrics;
 } architecture_state;
 
@@ -1,202 +1,415 @@
 #include "cache.h"
+#include "cache_replacement.h"
+#include "cache_hierarchy.h"
+#include "coherence.h"
+#include "write_buffer.h"
+#include "prefetcher.h"
+#include "cache_events.h"
+#include "sim_random.h"
 #include <string.h>
+#include <pthread.h>
 
-CacheEntry cache[CACHE_SIZE];
-CacheAccess access_history[MAX_ACCESS_HISTORY];
-int access_count = 0;
+l1_cache cache[NUM_CORES];
 bool cache_enabled = true;
 
-static InstructionPattern known_patterns[MAX_PATTERNS] = { 
-    {"LOAD C0", 0, true, 1},
-    {"LOAD B0", 0, true, 1}, 
-    {"LOOP", 0, true, 2},
-    {"MUL", 0, false, 0},
-    {"STORE", 0, true, 1}
-};
+// Contadores globais da L1 (a análise por linha fica no sidecar)
+static int l1_hits[NUM_CORES];
+static int l1_misses[NUM_CORES];
+static int prefetch_hit_count = 0;
+
+// Sidecar de diagnóstico: NUM_CORES * CACHE_SIZE entradas, NULL se desligado
+static line_diagnostics* diagnostics = NULL;
+
+// RAM de onde as linhas são copiadas e para onde voltam os bytes sujos
+static char* backing_memory = NULL;
+static size_t backing_size = 0;
+
+// Tráfego de escrita: STOREs (um por bloco tocado) contra escritas na memória
+static int store_count = 0;
+static int store_bytes = 0;
+static int write_misses = 0;         // STORE sem o bloco na L1
+static int dirty_writebacks = 0;     // Linhas sujas devolvidas à memória
+static int writeback_bytes = 0;
+static long writeback_cycles = 0;
+
+// Relógio de acessos: último uso de cada linha (diagnóstico)
+static unsigned long access_clock = 0;
+
+// Política de substituição ativa e o estado dela em cada conjunto
+static const ReplacementPolicy* replacement = NULL;
+static repl_set_state repl_sets[NUM_CORES][CACHE_SETS];
+
+// Residência por processo para o escalonador cache-aware: cópias de cada
+// bloco em L1/L2/LLC e, por região acompanhada, quantos dos seus blocos têm
+// ao menos uma cópia. Atualizado nos fills e evicções, lido sem varredura.
+typedef struct {
+    int pid;
+    unsigned int first_block;
+    unsigned int last_block;
+    int resident_blocks;
+} tracked_region;
+
+static unsigned short block_copies[NUM_BLOCKS];
+static tracked_region* regions = NULL;  // Regiões vivas (compacta)
+static int region_count = 0;
+static int region_capacity = 0;
+static int* region_of_pid = NULL;       // Índice em regions, -1 = não acompanhado
+static int pid_capacity = 0;
+static pthread_mutex_t residency_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void count_block(unsigned int block, int delta) {
+    for (int i = 0; i < region_count; i++) {
+        if (block >= regions[i].first_block && block <= regions[i].last_block) {
+            regions[i].resident_blocks += delta;
+        }
+    }
+}
+
+// Uma cópia do bloco entrou (+1) ou saiu (-1) de algum nível da hierarquia
+void cache_block_residency(unsigned int block, int delta) {
+    if (block >= NUM_BLOCKS) return;
+
+    pthread_mutex_lock(&residency_mutex);
+    if (delta > 0 && block_copies[block]++ == 0) count_block(block, 1);
+    if (delta < 0 && block_copies[block] > 0 && --block_copies[block] == 0) count_block(block, -1);
+    pthread_mutex_unlock(&residency_mutex);
+}
+
+// Passa a acompanhar a região do programa do processo (admissão)
+void cache_track_region(int pid, unsigned int base_address, unsigned int limit) {
+    if (pid < 0 || limit < base_address) return;
+
+    pthread_mutex_lock(&residency_mutex);
+    if (pid >= pid_capacity) {
+        int capacity = pid_capacity > 0 ? pid_capacity : 16;
+        while (capacity <= pid) capacity *= 2;
+        int* index = realloc(region_of_pid, capacity * sizeof(int));
+        if (!index) {
+            pthread_mutex_unlock(&residency_mutex);
+            return;
+        }
+        for (int i = pid_capacity; i < capacity; i++) index[i] = -1;
+        region_of_pid = index;
+        pid_capacity = capacity;
+    }
+    if (region_of_pid[pid] < 0 && region_count == region_capacity) {
+        int capacity = region_capacity > 0 ? region_capacity * 2 : 16;
+        tracked_region* grown = realloc(regions, capacity * sizeof(tracked_region));
+        if (!grown) {
+            pthread_mutex_unlock(&residency_mutex);
+            return;
+        }
+        regions = grown;
+        region_capacity = capacity;
+    }
+    if (region_of_pid[pid] < 0) region_of_pid[pid] = region_count++;
+
+    tracked_region* region = &regions[region_of_pid[pid]];
+    region->pid = pid;
+    region->first_block = base_address / BLOCK_SIZE;
+    region->last_block = limit / BLOCK_SIZE;
+    region->resident_blocks = 0;
+    for (unsigned int block = region->first_block;
+         block <= region->last_block && block < NUM_BLOCKS; block++) {
+        if (block_copies[block] > 0) region->resident_blocks++;
+    }
+    pthread_mutex_unlock(&residency_mutex);
+}
+
+// Processo terminou: a região sai da lista (a última ocupa o lugar)
+void cache_untrack_region(int pid) {
+    pthread_mutex_lock(&residency_mutex);
+    if (pid >= 0 && pid < pid_capacity && region_of_pid[pid] >= 0) {
+        int index = region_of_pid[pid];
+        regions[index] = regions[--region_count];
+        if (index < region_count) region_of_pid[regions[index].pid] = index;
+        region_of_pid[pid] = -1;
+    }
+    pthread_mutex_unlock(&residency_mutex);
+}
+
+// Fração dos blocos do programa presentes em alguma L1 ou na hierarquia
+// (cache "quente"); 0 para processo não acompanhado
+float cache_region_resident_fraction(int pid) {
+    float fraction = 0.0f;
+    pthread_mutex_lock(&residency_mutex);
+    if (pid >= 0 && pid < pid_capacity && region_of_pid[pid] >= 0) {
+        tracked_region* region = &regions[region_of_pid[pid]];
+        fraction = (float)region->resident_blocks /
+                   (region->last_block - region->first_block + 1);
+    }
+    pthread_mutex_unlock(&residency_mutex);
+    return fraction;
+}
+
+static void reset_residency(void) {
+    pthread_mutex_lock(&residency_mutex);
+    memset(block_copies, 0, sizeof(block_copies));
+    for (int i = 0; i < region_count; i++) regions[i].resident_blocks = 0;
+    pthread_mutex_unlock(&residency_mutex);
+}
+
+void cache_attach_memory(char* memory, size_t size) {
+    backing_memory = memory;
+    backing_size = size;
+}
+
+// Via do conjunto da L1 do core que guarda o bloco do endereço, ou -1
+static int find_way(int core_id, unsigned int address) {
+    unsigned int set = CACHE_INDEX(address);
+    unsigned int tag = CACHE_TAG(address);
+    const l1_cache* l1 = &cache[core_id];
+    for (int way = 0; way < CACHE_WAYS; way++) {
+        int line = set * CACHE_WAYS + way;
+        if ((l1->flags[line] & LINE_VALID) && l1->tag[line] == tag) return way;
+    }
+    return -1;
+}
+
+line_diagnostics* cache_line_diagnostics(int core_id, int line) {
+    return diagnostics ? &diagnostics[core_id * CACHE_SIZE + line] : NULL;
+}
+
+// Copia o bloco alinhado da RAM para a linha; a vítima suja volta à memória
+// e segue para a hierarquia. Devolve os ciclos do writeback da vítima.
+static int fill_line(int core_id, int line, unsigned int address) {
+    l1_cache* l1 = &cache[core_id];
+    unsigned int block_address = address - CACHE_OFFSET(address);
+    int latency = 0;
+    bool same_block = (l1->flags[line] & LINE_VALID) && l1->tag[line] == CACHE_TAG(address);
+    if ((l1->flags[line] & LINE_VALID) && !same_block) {
+        unsigned int victim = CACHE_BLOCK_ADDRESS(l1->tag[line], line / CACHE_WAYS);
+        latency = cache_writeback_line(core_id, line);
+        coherence_evicted(core_id, victim);
+        cache_block_residency(victim / BLOCK_SIZE, -1);
+        hierarchy_l1_evicted(core_id, victim);
+    }
+    if (!same_block) cache_block_residency(address / BLOCK_SIZE, 1);
+
+    memset(l1->data[line], 0, BLOCK_SIZE);
+    if (backing_memory && block_address < backing_size) {
+        size_t length = backing_size - block_address;
+        if (length > BLOCK_SIZE) length = BLOCK_SIZE;
+        memcpy(l1->data[line], backing_memory + block_address, length);
+    }
+    l1->tag[line] = CACHE_TAG(address);
+    l1->flags[line] = LINE_VALID;
+    l1->mesi[line] = MESI_EXCLUSIVE;  // Chamador ajusta conforme o snoop
+    l1->dirty_mask[line] = 0;
+
+    current_replacement_policy()->on_fill(&repl_sets[core_id][line / CACHE_WAYS], line % CACHE_WAYS);
+    return latency;
+}
+
+const ReplacementPolicy* current_replacement_policy(void) {
+    if (!replacement) replacement = get_replacement_policy(REPL_LRU);
+    return replacement;
+}
 
+// Trocar de política reinicia o estado dos conjuntos; as linhas continuam
+void set_replacement_policy(ReplacementType type) {
+    replacement = get_replacement_policy(type);
+    for (int core = 0; core < NUM_CORES; core++) {
+        for (int set = 0; set < CACHE_SETS; set++) {
+            replacement_init_set(&repl_sets[core][set], CACHE_WAYS);
+        }
+    }
+    replacement_seed(DEFAULT_SEED);
+}
 
 void set_cache_enabled(bool enabled) {
     cache_enabled = enabled;
     if (!enabled) {
         // Limpa completamente todas as estatísticas
         init_cache();  // Reinicializa a cache completamente
-        access_count = 0;
     }
 }
 
 void init_cache(void) {
-    for(int i = 0; i < CACHE_SIZE; i++) {
-        cache[i].tag = 0;
-        cache[i].data = NULL;
-        cache[i].last_used = 0;
-        cache[i].valid = false;
-        cache[i].dirty = false;
-        cache[i].hits = 0;
-        cache[i].misses = 0;
-        cache[i].hit_ratio = 0.0f;
-        cache[i].history_index = 0;
-        cache[i].temporal_locality_score = 0.0f;
-        cache[i].spatial_locality_score = 0.0f;
-        cache[i].prefetched = false;
-        cache[i].prefetch_hits = 0;
-        cache[i].prefetch_accuracy = 0.0f;
-        cache[i].current_instruction = NULL;
-        
-        memset(cache[i].access_history, 0, sizeof(cache[i].access_history));
-    }
-    access_count = 0;
-}
-
-bool check_cache(unsigned int address, char* current_instruction) {
-    if (!cache_enabled) {
-        return false;
+    access_clock = 0;
+    set_replacement_policy(current_replacement_policy()->type);
+    reset_cache_hierarchy();
+    reset_coherence();
+    reset_write_buffers();
+    reset_prefetchers();
+    store_count = store_bytes = write_misses = 0;
+    dirty_writebacks = writeback_bytes = 0;
+    writeback_cycles = 0;
+    memset(cache, 0, sizeof(cache));
+    reset_residency();
+    memset(l1_hits, 0, sizeof(l1_hits));
+    memset(l1_misses, 0, sizeof(l1_misses));
+    prefetch_hit_count = 0;
+
+    if (CACHE_DIAGNOSTICS) {
+        free(diagnostics);
+        diagnostics = calloc(NUM_CORES * CACHE_SIZE, sizeof(line_diagnostics));
     }
+}
 
-    unsigned idx = address % CACHE_SIZE;
-    bool is_hit = cache[idx].valid && cache[idx].tag == address;
-    bool was_prefetched = cache[idx].prefetched;
+void free_cache(void) {
+    free(diagnostics);
+    diagnostics = NULL;
+    free(regions);
+    regions = NULL;
+    region_count = region_capacity = 0;
+    free(region_of_pid);
+    region_of_pid = NULL;
+    pid_capacity = 0;
+}
 
-    printf("\n═══════════ Acesso à Cache ═══════════");
-    printf("\n┌── Endereço: %u", address);
-    printf("\n├── Instrução: %s", current_instruction);
+// Sidecar: contadores, último uso e texto da instrução de cada linha
+static void record_diagnostics(int core_id, int line, bool hit, const char* instruction) {
+    line_diagnostics* diag = cache_line_diagnostics(core_id, line);
+    if (!diag) return;
+
+    if (hit) diag->hits++;
+    else diag->misses++;
+    if (hit && (cache[core_id].flags[line] & LINE_PREFETCHED)) diag->prefetch_hits++;
+    diag->access_count++;
+    diag->last_used = ++access_clock;
+    diag->last_access = time(NULL);
+    if (instruction) {
+        strncpy(diag->last_instruction, instruction, DIAGNOSTIC_TEXT - 1);
+    }
+}
 
-    // Registrar instrução atual e atualizar histórico
-    if(current_instruction) {
-        if(cache[idx].current_instruction) {
-            free(cache[idx].current_instruction);
-        }
-        cache[idx].current_instruction = strdup(current_instruction);
+// Miss de busca à espera do fill: o diagnóstico é gravado na vítima que
+// allocate_line escolher (consultar a política aqui gastaria o sorteio do
+// Random e envelheceria os RRPVs do SRRIP/BRRIP)
+static char pending_miss_text[NUM_CORES][DIAGNOSTIC_TEXT];
+static bool pending_miss[NUM_CORES];
+
+// Demanda numa linha trazida por prefetch: o primeiro uso conta para o prefetcher
+static void note_prefetch_hit(int core_id, int line) {
+    l1_cache* l1 = &cache[core_id];
+    if (!(l1->flags[line] & LINE_PREFETCH_USED)) {
+        l1->flags[line] |= LINE_PREFETCH_USED;
+        prefetcher_record_use(core_id, l1->prefetch_source[line], l1->prefetch_ready[line]);
+    }
+    prefetch_hit_count++;
+}
 
-        if(access_count < MAX_ACCESS_HISTORY) {
-            strncpy(access_history[access_count].instruction, current_instruction, 49);
-            access_history[access_count].was_hit = is_hit;
-            access_history[access_count].access_time = time(NULL);
-            access_count++;
-        }
+bool check_cache(int core_id, unsigned int address, char* current_instruction) {
+    if (!cache_enabled) {
+        return false;
     }
 
-    // Atualizar estatísticas e mostrar resultado
+    unsigned int set = CACHE_INDEX(address);
+    int way = find_way(core_id, address);
+    bool is_hit = way >= 0;
+    int line = set * CACHE_WAYS + way;
+    bool was_prefetched = is_hit && (cache[core_id].flags[line] & LINE_PREFETCHED);
+
+    replacement_trace_record(core_id, address);
+    coherence_note_access(core_id, address, 1);
+
+    // Atualizar estatísticas; a saída fica com o sink de eventos
     if(is_hit) {
-        cache[idx].hits++;
-        if(was_prefetched) {
-            cache[idx].prefetch_hits++;
-            printf("\n├── Resultado: ✓ HIT (prefetched)");
-            printf("\n├── Bloco: %d", idx);
-            printf("\n└── Ganho: %d ciclos", MISS_PENALTY);
-        } else {
-            printf("\n├── Resultado: ✓ HIT");
-            printf("\n├── Bloco: %d", idx);
-            printf("\n└── Ganho: %d ciclos", MISS_PENALTY);
-        }
+        l1_hits[core_id]++;
+        current_replacement_policy()->on_hit(&repl_sets[core_id][set], way);
+        if(was_prefetched) note_prefetch_hit(core_id, line);
+        record_diagnostics(core_id, line, true, current_instruction);
+        // No miss, os prefetchers treinam depois do fill (update_cache)
+        prefetcher_observe(core_id, address, address, true, false);
     } else {
-        cache[idx].misses++;
-        printf("\n├── Resultado: ✗ MISS");
-        printf("\n├── Bloco: %d", idx);
-        printf("\n└── Penalidade: %d ciclos", MISS_PENALTY);
-
-        // Análise de padrão e prefetch em caso de miss
-        if(current_instruction) {
-            printf("\n\n[Análise de Padrão]");
-            if(strstr(current_instruction, "LOAD") != NULL) {
-                printf("\n├── Padrão: LOAD detectado");
-                printf("\n├── Ação: Prefetch do próximo bloco");
-                printf("\n└── Bloco alvo: %d", (address / BLOCK_SIZE + 1) * BLOCK_SIZE);
-                prefetch_block(address + 1, 1);
-            }
-            else if(strstr(current_instruction, "LOOP") != NULL) {
-                int loop_size = estimate_loop_size(NULL, current_instruction);
-                printf("\n├── Padrão: LOOP detectado");
-                printf("\n├── Ação: Prefetch de %d blocos", loop_size);
-                printf("\n└── Início: bloco %d", address);
-                prefetch_block(address, loop_size);
+        l1_misses[core_id]++;
+        // No miss, o diagnóstico fica na linha que será substituída
+        if (diagnostics) {
+            pending_miss_text[core_id][0] = '\0';
+            if (current_instruction) {
+                strncpy(pending_miss_text[core_id], current_instruction, DIAGNOSTIC_TEXT - 1);
+                pending_miss_text[core_id][DIAGNOSTIC_TEXT - 1] = '\0';
             }
+            pending_miss[core_id] = true;
         }
     }
-    printf("\n═════════════════════════════════════\n");
 
-    // Atualizar hit ratio e outras métricas
-    if(cache[idx].hits + cache[idx].misses > 0) {
-        cache[idx].hit_ratio = (float)cache[idx].hits /
-                              (cache[idx].hits + cache[idx].misses);
-        if(was_prefetched) {
-            cache[idx].prefetch_accuracy = (float)cache[idx].prefetch_hits /
-                                         cache[idx].hits;
-        }
+    if (cache_event_handler) {
+        cache_event event = {
+            .type = is_hit ? CACHE_EVENT_HIT : CACHE_EVENT_MISS,
+            .core_id = core_id, .address = address, .set = set, .way = way,
+            .prefetched = was_prefetched, .instruction = current_instruction
+        };
+        cache_event_handler(&event);
     }
 
-    cache[idx].last_access = time(NULL);
-    cache[idx].access_count++;
-
     return is_hit;
 }
 
 
-float get_speedup_ratio(void) {
-    int total_hits = 0, total_misses = 0;
-    
-    for(int i = 0; i < CACHE_SIZE; i++) {
-        total_hits += cache[i].hits;
-        total_misses += cache[i].misses;
+static void count_l1_accesses(int* total_hits, int* total_misses) {
+    *total_hits = *total_misses = 0;
+    for(int core = 0; core < NUM_CORES; core++) {
+        *total_hits += l1_hits[core];
+        *total_misses += l1_misses[core];
     }
+}
+
+float get_speedup_ratio(void) {
+    int total_hits, total_misses;
+    count_l1_accesses(&total_hits, &total_misses);
     
     if (total_hits + total_misses == 0) return 1.0f;
     
-    // Calcular ciclos economizados
-    int cycles_with_cache = total_hits + (total_misses * MISS_PENALTY);
-    int cycles_without_cache = (total_hits + total_misses) * MISS_PENALTY;
+    // Sem cache toda busca vai à memória; com cache, misses pagam a hierarquia
+    long cycles_with_cache = (long)(total_hits + total_misses) * L1_LATENCY +
+                             hierarchy_miss_cycles();
+    long cycles_without_cache = (long)(total_hits + total_misses) * MEMORY_LATENCY;
     
     return cycles_without_cache / (float)cycles_with_cache;
 }
 
-void prefetch_block(unsigned int base_address, int distance) {
-    if (!cache_enabled) return;
-    //printf("\n[Prefetch] Iniciando prefetch para endereço base %u", base_address);
-
-    // Calcular próximos endereços sequencialmente
-    for(int i = 1; i <= distance; i++) {
-        // Agora vamos incrementar apenas em 1 unidade, não em BLOCK_SIZE
-        unsigned int next_address = base_address + i;
-        int idx = next_address % CACHE_SIZE;
-        
-        // Se o bloco já está na cache, pula
-        if(cache[idx].valid && cache[idx].tag == next_address) {
-            // printf("\n[Prefetch] Endereço %u já está na cache", next_address);
-            continue;
-        }
-
-        // printf("\n[Prefetch] Pré-carregando endereço %u em bloco %d", next_address, idx);
-        
-        // Limpar bloco antigo se necessário
-        if(cache[idx].current_instruction) {
-            free(cache[idx].current_instruction);
-            cache[idx].current_instruction = NULL;
-        }
-
-        // Atualizar bloco
-        cache[idx].tag = next_address;
-        cache[idx].valid = true;
-        cache[idx].prefetched = true;
-        cache[idx].prefetch_hits = 0;
-        cache[idx].last_access = time(NULL);
-        
-        // printf("\n[Prefetch] Bloco %d marcado como prefetched", idx);
+// Prefetch do bloco do endereço para a L1 do core, marcado com a origem.
+// Devolve se o pedido foi emitido (bloco fora da L1 e dentro da RAM).
+bool prefetch_line(int core_id, unsigned int address, int source) {
+    if (!cache_enabled) return false;
+    if (backing_memory && address >= backing_size) return false;
+    if (find_way(core_id, address) >= 0) return false;
+
+    l1_cache* l1 = &cache[core_id];
+    unsigned int set = CACHE_INDEX(address);
+    int way = find_victim_way(core_id, set);
+    int line = set * CACHE_WAYS + way;
+
+    // Prefetch não atrasa o core: a latência só define quando o bloco chega
+    int latency = hierarchy_prefetch(core_id, address);
+    fill_line(core_id, line, address);
+    l1->mesi[line] = coherence_read_fill(core_id, address, &latency);
+    l1->flags[line] |= LINE_PREFETCHED;
+    l1->prefetch_source[line] = source;
+    l1->prefetch_ready[line] = prefetcher_now(core_id) + latency;
+
+    if (cache_event_handler) {
+        cache_event event = {
+            .type = CACHE_EVENT_PREFETCH, .core_id = core_id, .address = address,
+            .set = set, .way = way, .latency = latency
+        };
+        cache_event_handler(&event);
     }
+    return true;
 }
 
-int estimate_loop_size(char* content __attribute__((unused)), char* loop_start) {
-    if(!loop_start) return 0;
-    
-    int count = 0;
-    char* end = strstr(loop_start, "L_END");
-    
-    if(end) {
-        char* curr = loop_start;
-        while(curr < end) {
-            if(*curr == '\n') count++;
-            curr++;
-        }
+static void print_write_policy_statistics(void) {
+    int memory_writes = dirty_writebacks + write_buffer_memory_writes();
+
+    printf("\n\n╔═══════════ Política de Escrita ═══════════╗");
+    printf("\n║ %s, %s",
+           WRITE_POLICY == WRITE_BACK ? "Write-back" : "Write-through",
+           WRITE_ALLOCATE ? "write-allocate" : "no-write-allocate");
+    printf("\n║ STOREs: %d (%d bytes), misses de escrita: %d",
+           store_count, store_bytes, write_misses);
+    printf("\n║ Writebacks de linhas sujas: %d (%d bytes, %ld ciclos)",
+           dirty_writebacks, writeback_bytes, writeback_cycles);
+    print_write_buffer_statistics();
+    printf("\n╠═══════════════════════════════════════════╣");
+    printf("\n║ Escritas na memória: %d (%d bytes)", memory_writes,
+           writeback_bytes + write_buffer_memory_bytes());
+    if (store_count > 0) {
+        printf("\n║ Redução do tráfego de escrita: %.1f%%",
+               (1.0f - (float)memory_writes / store_count) * 100);
     }
-    return count > 0 ? count : 2;  // Mínimo de 2 blocos para LOOP
+    printf("\n╚═══════════════════════════════════════════╝\n");
 }
 
 void print_cache_statistics(void) {
@@ -207,12 +420,8 @@ void print_cache_statistics(void) {
     printf("\n\n╔═══════════ Resumo de Cache ═══════════╗");
 
     // Estatísticas globais
-    int total_hits = 0, total_misses = 0, total_prefetch_hits = 0;
-    for(int i = 0; i < CACHE_SIZE; i++) {
-        total_hits += cache[i].hits;
-        total_misses += cache[i].misses;
-        total_prefetch_hits += cache[i].prefetch_hits;
-    }
+    int total_hits, total_misses;
+    count_l1_accesses(&total_hits, &total_misses);
 
     printf("\n║ Desempenho Global                      ║");
     printf("\n╠═══════════════════════════════════════╣");
@@ -223,208 +432,379 @@ void print_cache_statistics(void) {
     printf("\n║ ├── Hit Ratio: %.1f%%                 ║",
            (float)total_hits / (total_hits + total_misses) * 100);
     printf("\n║ └── Prefetch Hits: %-6d              ║",
-           total_prefetch_hits);
+           prefetch_hit_count);
 
-    // Análise de ciclos
-    int ciclos_salvos = total_hits * (MISS_PENALTY - 1);
-    int ciclos_perdidos = total_misses * MISS_PENALTY;
+    // Análise de ciclos: referência é buscar tudo da memória
+    long ciclos_perdidos = hierarchy_miss_cycles();
+    long ciclos_salvos = (long)(total_hits + total_misses) * (MEMORY_LATENCY - L1_LATENCY) -
+                         ciclos_perdidos;
 
     printf("\n║                                       ║");
     printf("\n║ Impacto no Desempenho                 ║");
     printf("\n╠═══════════════════════════════════════╣");
-    printf("\n║ ├── Ciclos Economizados: %-6d       ║", ciclos_salvos);
-    printf("\n║ ├── Ciclos Perdidos: %-6d           ║", ciclos_perdidos);
+    printf("\n║ ├── Ciclos Economizados: %-6ld       ║", ciclos_salvos);
+    printf("\n║ ├── Ciclos Perdidos: %-6ld           ║", ciclos_perdidos);
     printf("\n║ └── Speedup: %.2fx                    ║",
            get_speedup_ratio());
 
     printf("\n╚═══════════════════════════════════════╝\n");
+
+    print_hierarchy_statistics();
+    print_coherence_statistics();
+    print_write_policy_statistics();
+    print_prefetch_statistics();
 }
 
 
-int find_lru_entry(void) {
-    int lru_index = 0;
-    time_t min_access = cache[0].last_access;  // Usar last_access em vez de last_used
-    
-    for(int i = 1; i < CACHE_SIZE; i++) {
-        if(!cache[i].valid) {  // Primeiro procurar entrada vazia
-            return i;
-        }
-        if(cache[i].last_access < min_access) {
-            min_access = cache[i].last_access;
-            lru_index = i;
+// Vítima dentro do conjunto: primeira via inválida, senão a escolhida pela política
+int find_victim_way(int core_id, unsigned int set) {
+    const uint8_t* flags = &cache[core_id].flags[set * CACHE_WAYS];
+
+    for(int way = 0; way < CACHE_WAYS; way++) {
+        if(!(flags[way] & LINE_VALID)) {
+            return way;
         }
     }
-    return lru_index;
+    return current_replacement_policy()->select_victim(&repl_sets[core_id][set]);
+}
+
+// Busca o bloco na hierarquia e o copia para a vítima do conjunto.
+// Devolve os ciclos de stall do miss, ou -1 se o bloco já estava na L1.
+// fetch_miss: fill de um miss de busca, cujo diagnóstico está pendente.
+static int allocate_line(int core_id, unsigned int address, bool fetch_miss) {
+    l1_cache* l1 = &cache[core_id];
+    unsigned int set = CACHE_INDEX(address);
+    int way = find_way(core_id, address);
+    if (way >= 0) return -1;
+
+    way = find_victim_way(core_id, set);
+    int line = set * CACHE_WAYS + way;
+    bool eviction = l1->flags[line] & LINE_VALID;
+
+    if (fetch_miss && pending_miss[core_id]) {
+        record_diagnostics(core_id, line, false, pending_miss_text[core_id]);
+        pending_miss[core_id] = false;
+    }
+    unsigned int victim_address = CACHE_BLOCK_ADDRESS(l1->tag[line], set);
+    int latency = hierarchy_fetch(core_id, address);
+
+    latency += fill_line(core_id, line, address);
+
+    if (cache_event_handler) {
+        cache_event event = {
+            .type = CACHE_EVENT_FILL, .core_id = core_id, .address = address,
+            .set = set, .way = way, .latency = latency,
+            .eviction = eviction, .victim_address = victim_address
+        };
+        cache_event_handler(&event);
+    }
+    return latency;
+}
+
+// Miss de leitura: o snoop define se a linha entra em E ou S e vem antes
+// do fill (um dono M devolve o bloco à RAM antes da cópia). Devolve os
+// ciclos do miss ou -1 sem linha alocada.
+static int read_fill(int core_id, unsigned int address, bool fetch_miss) {
+    int coherence_latency = 0;
+    MesiState state = coherence_read_fill(core_id, address, &coherence_latency);
+
+    int latency = allocate_line(core_id, address, fetch_miss);
+    if (latency < 0) return -1;
+
+    cache[core_id].mesi[cache_find_line(core_id, address)] = state;
+    return latency + coherence_latency;
+}
+
+int update_cache(int core_id, unsigned int address) {
+    if (!cache_enabled || find_way(core_id, address) >= 0) return 0;
+
+    int latency = read_fill(core_id, address, true);
+    if (latency < 0) return 0;
+
+    prefetcher_observe(core_id, address, address, false, false);
+    return latency;
+}
+
+// Miss de escrita: o protocolo já invalidou as outras cópias e marca a linha M
+int cache_write_allocate(int core_id, unsigned int address) {
+    int latency = allocate_line(core_id, address, false);
+    return latency < 0 ? 0 : latency;
+}
+
+// Linha válida da L1 do core com o bloco do endereço, ou -1
+int cache_find_line(int core_id, unsigned int address) {
+    int way = find_way(core_id, address);
+    if (way < 0) return -1;
+    return CACHE_INDEX(address) * CACHE_WAYS + way;
+}
+
+// Linha deixa a L1 sem writeback (o chamador já cuidou dos dados)
+void cache_drop_line(int core_id, int line) {
+    if (cache[core_id].flags[line] & LINE_VALID) {
+        cache_block_residency(CACHE_BLOCK_ADDRESS(cache[core_id].tag[line], line / CACHE_WAYS) /
+                              BLOCK_SIZE, -1);
+    }
+    cache[core_id].flags[line] = 0;
+    cache[core_id].mesi[line] = MESI_INVALID;
+    cache[core_id].dirty_mask[line] = 0;
 }
 
-void update_cache(unsigned int address, char* data) {
+// Aquece a LLC com o bloco (escalonador escolhendo um processo)
+void cache_warm_block(unsigned int address) {
     if (!cache_enabled) return;
+    hierarchy_warm(address);
+}
+
+// Remove o bloco da L1 do core (inclusão/coerência), devolvendo os bytes
+// sujos à memória. Devolve se estava presente.
+bool cache_invalidate_block(int core_id, unsigned int address) {
+    int line = cache_find_line(core_id, address);
+    if (line < 0) return false;
+
+    cache_writeback_line(core_id, line);
+    coherence_evicted(core_id, address);
+    cache_drop_line(core_id, line);
+    return true;
+}
+
+// Programa novo carregado na região: cópias antigas são descartadas sem
+// writeback (o conteúdo da RAM já é o novo)
+void cache_invalidate_range(unsigned int base_address, unsigned int size) {
+    if (!cache_enabled || size == 0) return;
+
+    unsigned int first = base_address / BLOCK_SIZE;
+    unsigned int last = (base_address + size - 1) / BLOCK_SIZE;
+    for (unsigned int block = first; block <= last; block++) {
+        for (int core = 0; core < NUM_CORES; core++) {
+            int line = cache_find_line(core, block * BLOCK_SIZE);
+            if (line < 0) continue;
+            coherence_evicted(core, block * BLOCK_SIZE);
+            cache_drop_line(core, line);
+        }
+    }
+}
+
+// Devolve à RAM só os bytes escritos desde o fill. Devolve os ciclos de
+// memória gastos (0 se a linha estava limpa).
+int cache_writeback_line(int core_id, int line) {
+    l1_cache* l1 = &cache[core_id];
+    if ((l1->flags[line] & (LINE_VALID | LINE_DIRTY)) != (LINE_VALID | LINE_DIRTY)) return 0;
+
+    unsigned int block_address = CACHE_BLOCK_ADDRESS(l1->tag[line], line / CACHE_WAYS);
+    uint32_t mask = l1->dirty_mask[line];
+    for (int i = 0; i < BLOCK_SIZE && backing_memory; i++) {
+        if ((mask >> i & 1) && block_address + i < backing_size) {
+            backing_memory[block_address + i] = l1->data[line][i];
+        }
+    }
 
-    unsigned idx = address % CACHE_SIZE;
-
-    printf("\n╔═══════════ Atualização de Bloco ═══════════╗");
-    printf("\n║ Endereço: 0x%04X → Bloco %d              ║",
-           address, idx);
-
-    if(cache[idx].valid && cache[idx].tag != address) {
-        cache[idx].misses++;
-        int lru_idx = find_lru_entry();
-        printf("\n║ ├── Conflito detectado                     ║");
-        printf("\n║ │   ├── Tag antiga: 0x%04X                ║",
-               cache[idx].tag);
-        printf("\n║ │   └── Nova tag: 0x%04X                  ║",
-               address);
-        printf("\n║ │   └── LRU: BLOCO %d substituído (idade: %d ciclos)║",
-               lru_idx, cache[lru_idx].age);
-    }
-
-    // Atualizar estatísticas
-    cache[idx].tag = address;
-    cache[idx].data = data;
-    cache[idx].valid = true;
-    cache[idx].access_count++;
-    cache[idx].last_access = time(NULL);
-
-    printf("\n║ └── Estado após atualização                ║");
-    printf("\n║     ├── Acessos: %-4d                     ║",
-           cache[idx].access_count);
-    printf("\n║     ├── Hits: %-4d                        ║",
-           cache[idx].hits);
-    printf("\n║     └── Hit Ratio: %.1f%%                 ║",
-           cache[idx].hit_ratio * 100);
-
-    printf("\n╚═════════════════════════════════════════════╝\n");
-
-    if (cache[idx].hits + cache[idx].misses > 0) {
-        cache[idx].hit_ratio = (float)cache[idx].hits /
-                            (cache[idx].hits + cache[idx].misses);
-    }
-
-    // Envelhecer outros blocos
-    for(unsigned int i = 0; i < CACHE_SIZE; i++) {
-        if(i != idx && cache[i].valid) {
-            cache[i].age++;
+    dirty_writebacks++;
+    writeback_bytes += __builtin_popcount(mask);
+    writeback_cycles += MEMORY_LATENCY;
+    l1->flags[line] &= ~LINE_DIRTY;
+    l1->dirty_mask[line] = 0;
+
+    if (cache_event_handler) {
+        cache_event event = {
+            .type = CACHE_EVENT_WRITEBACK, .core_id = core_id, .address = block_address,
+            .set = line / CACHE_WAYS, .way = line % CACHE_WAYS, .latency = MEMORY_LATENCY
+        };
+        cache_event_handler(&event);
+    }
+    return MEMORY_LATENCY;
+}
+
+// STORE do core pela L1, bloco a bloco, conforme a política de escrita.
+// `pc` é o endereço da instrução (treina o prefetcher de stride).
+// Devolve os ciclos de stall (posse do bloco, miss, writeback, buffer cheio).
+int cache_store(int core_id, unsigned int pc, unsigned int address, const char* data, int length) {
+    l1_cache* l1 = &cache[core_id];
+    int latency = 0;
+
+    while (length > 0) {
+        unsigned int offset = CACHE_OFFSET(address);
+        int chunk = BLOCK_SIZE - offset < (unsigned int)length ? (int)(BLOCK_SIZE - offset) : length;
+        uint32_t written = CACHE_BYTE_MASK(offset, chunk);
+
+        store_count++;
+        store_bytes += chunk;
+        int line = cache_find_line(core_id, address);
+        bool hit = line >= 0;
+        if (!hit) write_misses++;
+        else if (l1->flags[line] & LINE_PREFETCHED) note_prefetch_hit(core_id, line);
+
+        latency += coherence_write(core_id, address, written, WRITE_ALLOCATE);
+        line = cache_find_line(core_id, address);
+        if (line >= 0) {
+            memcpy(l1->data[line] + offset, data, chunk);
+            if (WRITE_POLICY == WRITE_BACK) {
+                l1->flags[line] |= LINE_DIRTY;
+                l1->dirty_mask[line] |= written;
+            }
         }
+
+        // Write-through, ou miss sem write-allocate: a escrita vai à memória
+        if (line < 0 || WRITE_POLICY == WRITE_THROUGH) {
+            if (backing_memory && address + chunk <= backing_size) {
+                memcpy(backing_memory + address, data, chunk);
+            }
+            latency += write_buffer_put(core_id, address, chunk);
+        }
+        prefetcher_observe(core_id, pc, address, hit, true);
+
+        address += chunk;
+        data += chunk;
+        length -= chunk;
     }
+    return latency;
+}
 
-    print_cache_state();
+// LOAD de memória do core pela L1, bloco a bloco: o miss traz o bloco e os
+// bytes saem da linha. Devolve os ciclos de stall dos misses.
+int cache_load(int core_id, unsigned int pc, unsigned int address, char* data, int length) {
+    l1_cache* l1 = &cache[core_id];
+    int latency = 0;
+
+    while (length > 0) {
+        unsigned int offset = CACHE_OFFSET(address);
+        int chunk = BLOCK_SIZE - offset < (unsigned int)length ? (int)(BLOCK_SIZE - offset) : length;
+        unsigned int set = CACHE_INDEX(address);
+        int way = find_way(core_id, address);
+        bool hit = way >= 0;
+
+        coherence_note_access(core_id, address, chunk);
+        if (hit) {
+            int line = set * CACHE_WAYS + way;
+            l1_hits[core_id]++;
+            current_replacement_policy()->on_hit(&repl_sets[core_id][set], way);
+            if (l1->flags[line] & LINE_PREFETCHED) note_prefetch_hit(core_id, line);
+        } else {
+            l1_misses[core_id]++;
+            int miss_latency = read_fill(core_id, address, false);
+            if (miss_latency > 0) latency += miss_latency;
+        }
+        prefetcher_observe(core_id, pc, address, hit, true);
 
+        int line = cache_find_line(core_id, address);
+        if (line >= 0) {
+            memcpy(data, l1->data[line] + offset, chunk);
+        } else if (backing_memory && address + chunk <= backing_size) {
+            memcpy(data, backing_memory + address, chunk);
+        }
 
+        address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    return latency;
+}
+
+// Fim da execução: linhas sujas e buffers pendentes chegam à memória
+void cache_flush_dirty_lines(void) {
+    if (!cache_enabled) return;
+    for (int core = 0; core < NUM_CORES; core++) {
+        for (int line = 0; line < CACHE_SIZE; line++) {
+            cache_writeback_line(core, line);
+        }
+    }
+    write_buffer_drain();
 }
-float calculate_cache_efficiency(int index) {
-    if(cache[index].hits + cache[index].misses == 0) {
+
+float calculate_cache_efficiency(int core_id, int index) {
+    line_diagnostics* diag = cache_line_diagnostics(core_id, index);
+    if(!diag || diag->hits + diag->misses == 0) {
         return 0.0f;
     }
     
-    float hit_ratio = cache[index].hit_ratio;
-    float access_factor = (float)cache[index].access_count / MAX_ACCESS_HISTORY;
-    float age_factor = 1.0f / (cache[index].age + 1);
+    float hit_ratio = (float)diag->hits / (diag->hits + diag->misses);
+    float access_factor = (float)diag->access_count / MAX_ACCESS_HISTORY;
+    // Idade: acessos desde o último uso da linha
+    float age_factor = 1.0f / (access_clock - diag->last_used + 1);
     
     return (hit_ratio * 0.5f + access_factor * 0.3f + age_factor * 0.2f) * 100.0f;
 }
 
-void print_cache_state(void) {
+void print_cache_state(int core_id) {
     // printf("\n[Cache] Estado atual:");
+    const l1_cache* l1 = &cache[core_id];
     for(int i = 0; i < CACHE_SIZE; i++) {
-        if(cache[i].valid) {
-            printf("\n[%d]: tag=%u, último uso=%d", 
-                   i, cache[i].tag, cache[i].last_used);
-        }
-    }
-}
-    
-void analyze_instruction_pattern(char* content, unsigned int address) {
-    static bool address_processed[MAX_PROCESSES] = {false};
-    
-    if (address_processed[address / CACHE_SIZE]) {
-        return;  // Já processou este endereço
-    }
-    
-    for(int i = 0; i < MAX_PATTERNS; i++) {
-        int pattern_len = strlen(known_patterns[i].pattern);
-        char* match = strstr(content, known_patterns[i].pattern);
-        
-        while(match) {
-            bool prefix_check = (match == content) || !isalnum(*(match-1));
-            bool suffix_check = !isalnum(*(match + pattern_len));
-            
-            if(prefix_check && suffix_check) {
-                known_patterns[i].frequency++;
-                break;  // Contar apenas uma vez por padrão
-            }
-            
-            match = strstr(match + pattern_len, known_patterns[i].pattern);
+        if(l1->flags[i] & LINE_VALID) {
+            line_diagnostics* diag = cache_line_diagnostics(core_id, i);
+            printf("\n[%d/%d]: tag=%u", i / CACHE_WAYS, i % CACHE_WAYS, l1->tag[i]);
+            if (diag) printf(", último uso=%lu", diag->last_used);
         }
     }
-    
-    address_processed[address / CACHE_SIZE] = true;
 }
 
+// Leitura de um byte pela L1 do core (a linha precisa estar presente)
+bool cache_read_byte(int core_id, unsigned int address, char* value) {
+    int line = cache_find_line(core_id, address);
+    if (line < 0 || !value) return false;
 
-void print_instruction_patterns() {
-    printf("\n═════════════════════════════════════\n");
-    printf("\n[Cache] Análise de Padrões de Instrução:");
-    for(int i = 0; i < MAX_PATTERNS; i++) {
-        if(known_patterns[i].frequency > 0) {
-            printf("\nPadrão: %s, Frequência: %d", 
-                   known_patterns[i].pattern, 
-                   known_patterns[i].frequency);
-        }
-    }
+    *value = cache[core_id].data[line][CACHE_OFFSET(address)];
+    return true;
 }
 
+// Análise por linha: só com o sidecar de diagnóstico (CACHE_DIAGNOSTICS)
 void print_block_details(void) {
+    if (!diagnostics) return;
+
     printf("\n╔═══════════ Análise de Blocos de Cache ═══════════╗");
 
-    for(int i = 0; i < CACHE_SIZE; i++) {
-        if(cache[i].access_count > 0) {
-            printf("\n║                                               ║");
-            printf("\n║ Bloco %2d                                     ║", i);
-            printf("\n╠═══════════════════════════════════════════════╣");
-            printf("\n║ ├── Estado                                    ║");
-            printf("\n║ │   ├── Válido: %s                        ║",
-                   cache[i].valid ? "Sim" : "Não");
-            printf("\n║ │   ├── Tag: 0x%04X                          ║",
-                   cache[i].tag);
-            printf("\n║ │   └── Dirty: %s                         ║",
-                   cache[i].dirty ? "Sim" : "Não");
-
-            printf("\n║ ├── Estatísticas                             ║");
-            printf("\n║ │   ├── Acessos: %-4d                        ║",
-                   cache[i].access_count);
-            printf("\n║ │   ├── Hits: %-4d                           ║",
-                   cache[i].hits);
-            printf("\n║ │   ├── Misses: %-4d                         ║",
-                   cache[i].misses);
-            printf("\n║ │   └── Hit Ratio: %.1f%%                    ║",
-                   cache[i].hit_ratio * 100);
-
-            printf("\n║ ├── Prefetching                              ║");
-            printf("\n║ │   ├── Foi prefetched: %s                ║",
-                   cache[i].prefetched ? "Sim" : "Não");
-            printf("\n║ │   ├── Prefetch hits: %-4d                  ║",
-                   cache[i].prefetch_hits);
-            printf("\n║ │   └── Precisão: %.1f%%                     ║",
-                   cache[i].prefetch_accuracy * 100);
-
-            printf("\n║ ├── Temporalidade                            ║");
-            printf("\n║ │   └── Último acesso: %lds atrás            ║",
-                   time(NULL) - cache[i].last_access);
-
-            if(cache[i].current_instruction) {
-                printf("\n║ └── Última Instrução                         ║");
-                printf("\n║     └── %s                      ║",
-                       cache[i].current_instruction);
+    for(int core = 0; core < NUM_CORES; core++) {
+        const l1_cache* l1 = &cache[core];
+        for(int i = 0; i < CACHE_SIZE; i++) {
+            line_diagnostics* diag = cache_line_diagnostics(core, i);
+            if(diag->access_count > 0) {
+                int accesses = diag->hits + diag->misses;
+                printf("\n║                                               ║");
+                printf("\n║ Core %d, conjunto %2d, via %d                   ║", core, i / CACHE_WAYS, i % CACHE_WAYS);
+                printf("\n╠═══════════════════════════════════════════════╣");
+                printf("\n║ ├── Estado                                    ║");
+                printf("\n║ │   ├── Válido: %s                        ║",
+                       (l1->flags[i] & LINE_VALID) ? "Sim" : "Não");
+                printf("\n║ │   ├── Tag: 0x%04X                          ║",
+                       l1->tag[i]);
+                printf("\n║ │   └── Dirty: %s                         ║",
+                       (l1->flags[i] & LINE_DIRTY) ? "Sim" : "Não");
+
+                printf("\n║ ├── Estatísticas                             ║");
+                printf("\n║ │   ├── Acessos: %-4d                        ║",
+                       diag->access_count);
+                printf("\n║ │   ├── Hits: %-4d                           ║",
+                       diag->hits);
+                printf("\n║ │   ├── Misses: %-4d                         ║",
+                       diag->misses);
+                printf("\n║ │   └── Hit Ratio: %.1f%%                    ║",
+                       accesses > 0 ? (float)diag->hits * 100 / accesses : 0.0f);
+
+                printf("\n║ ├── Prefetching                              ║");
+                printf("\n║ │   ├── Foi prefetched: %s                ║",
+                       (l1->flags[i] & LINE_PREFETCHED) ? "Sim" : "Não");
+                printf("\n║ │   ├── Prefetch hits: %-4d                  ║",
+                       diag->prefetch_hits);
+                printf("\n║ │   └── Precisão: %.1f%%                     ║",
+                       diag->hits > 0 ? (float)diag->prefetch_hits * 100 / diag->hits : 0.0f);
+
+                printf("\n║ ├── Temporalidade                            ║");
+                printf("\n║ │   └── Último acesso: %lds atrás            ║",
+                       time(NULL) - diag->last_access);
+
+                if(diag->last_instruction[0]) {
+                    printf("\n║ └── Última Instrução                         ║");
+                    printf("\n║     └── %s                      ║",
+                           diag->last_instruction);
+                }
+
+                printf("\n╠═══════════════════════════════════════════════╣");
+
+                // Resumo de eficiência do bloco
+                float efficiency = (diag->hits * 100.0f) /
+                                 (diag->hits + diag->misses * average_miss_penalty());
+                printf("\n║ Eficiência do Bloco: %.1f%%                    ║",
+                       efficiency);
             }
-
-            printf("\n╠═══════════════════════════════════════════════╣");
-
-            // Resumo de eficiência do bloco
-            float efficiency = (cache[i].hits * 100.0f) /
-                             (cache[i].hits + cache[i].misses * MISS_PENALTY);
-            printf("\n║ Eficiência do Bloco: %.1f%%                    ║",
-                   efficiency);
         }
     }
     printf("\n╚═══════════════════════════════════════════════╝");
-}
\ No newline at end of file
+}
@@ -3,86 +3,132 @@
 
 #include "pcb.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <math.h>
 #include <time.h>
 
-#define CACHE_SIZE 1024   
-#define MISS_PENALTY 20        
+// Geometria da L1 de cada core: CACHE_SIZE linhas de BLOCK_SIZE bytes em
+// conjuntos de CACHE_WAYS vias (CACHE_WAYS 1 = mapeamento direto). Potências de 2.
+#ifndef CACHE_SIZE
+#define CACHE_SIZE 32
+#endif
+#ifndef CACHE_WAYS
+#define CACHE_WAYS 4
+#endif
+#define BLOCK_SIZE 16
+#define CACHE_SETS (CACHE_SIZE / CACHE_WAYS)
+
 #define MAX_ACCESS_HISTORY 200 
-#define MAX_PATTERNS 16         
-#define MAX_PATTERN_LENGTH 100 
-#define BLOCK_SIZE 64         
+
+// Decomposição do endereço: | tag | índice do conjunto | offset no bloco |
+#define CACHE_OFFSET(address) ((address) % BLOCK_SIZE)
+#define CACHE_INDEX(address) (((address) / BLOCK_SIZE) % CACHE_SETS)
+#define CACHE_TAG(address) ((address) / BLOCK_SIZE / CACHE_SETS)
+#define CACHE_BLOCK_ADDRESS(tag, index) (((tag) * CACHE_SETS + (index)) * BLOCK_SIZE)
+
+// Bytes [offset, offset + length) do bloco como máscara (um bit por byte)
+#if BLOCK_SIZE > 32
+#error "Máscaras de bytes do bloco comportam até 32 bytes"
+#endif
+#define CACHE_BYTE_MASK(offset, length) \
+    ((((length) >= 32 ? UINT32_MAX : (1u << (length)) - 1)) << (offset))
+
+// Política de escrita da L1: write-back marca a linha suja e só devolve os
+// bytes modificados na evicção; write-through repassa cada STORE à memória
+// pelo buffer de escrita. Sem write-allocate, STORE em miss não traz o bloco.
+typedef enum {
+    WRITE_THROUGH,
+    WRITE_BACK
+} WritePolicy;
+
+#ifndef WRITE_POLICY
+#define WRITE_POLICY WRITE_BACK
+#endif
+#ifndef WRITE_ALLOCATE
+#define WRITE_ALLOCATE true
+#endif
 
 
 extern bool cache_enabled;
 
-// Estrutura para registrar acessos à cache
-typedef struct {
-    char instruction[50];
-    bool was_hit;
-    time_t access_time;
-} CacheAccess;
+// Estados MESI de uma linha de L1 (INVALID equivale a valid == false)
+typedef enum {
+   MESI_INVALID,
+   MESI_SHARED,
+   MESI_EXCLUSIVE,
+   MESI_MODIFIED
+} MesiState;
+
+// Flags de cada linha
+#define LINE_VALID          0x01
+#define LINE_DIRTY          0x02
+#define LINE_PREFETCHED     0x04  // Trazida por prefetcher
+#define LINE_PREFETCH_USED  0x08  // Já usada por demanda depois do prefetch
 
+// L1 de um core em vetores paralelos, só com o que o acesso consulta;
+// a via w do conjunto s é o índice s * CACHE_WAYS + w em todos eles
 typedef struct {
-    char pattern[MAX_PATTERN_LENGTH];
-    int frequency;
-    bool needs_prefetch;
-    int prefetch_distance;
-} InstructionPattern;
+   unsigned int tag[CACHE_SIZE];
+   uint8_t flags[CACHE_SIZE];
+   uint8_t mesi[CACHE_SIZE];                 // MesiState
+   uint8_t prefetch_source[CACHE_SIZE];      // PrefetchSource (prefetcher.h)
+   uint32_t dirty_mask[CACHE_SIZE];          // Bytes escritos desde o fill (write-back)
+   unsigned long prefetch_ready[CACHE_SIZE]; // Quando o bloco prefetched chega
+   char data[CACHE_SIZE][BLOCK_SIZE];        // Cópia dos bytes do bloco na RAM
+} l1_cache;
+
+// Análise por linha fora do caminho de acesso: só é alocada com diagnóstico
+#ifndef CACHE_DIAGNOSTICS
+#define CACHE_DIAGNOSTICS false
+#endif
+#define DIAGNOSTIC_TEXT 48
 
 typedef struct {
-   unsigned int tag;
-   char* data;
-   int last_used;
-   bool valid;
-   bool dirty;
    int hits;
    int misses;
-   float hit_ratio;
-   time_t last_access;
    int access_count;
-   int age;
-   time_t creation_time;
-   int reuse_count;
-   float efficiency_score;
-   
-   // Para análise de padrões de acesso
-   int access_history[MAX_ACCESS_HISTORY];
-   int history_index;
-   float temporal_locality_score;
-   float spatial_locality_score;
-   
-   // Novos campos para prefetch
-   bool prefetched;
    int prefetch_hits;
-   float prefetch_accuracy;
-   char* current_instruction;
-} CacheEntry;
-
-// Adicione às funções declaradas
-float calculate_instruction_similarity(const char* instr1, const char* instr2);
+   unsigned long last_used;   // Relógio de acessos
+   time_t last_access;
+   char last_instruction[DIAGNOSTIC_TEXT];
+} line_diagnostics;
 
-// Funções principais
+// Funções principais (L1 privada de cada core; níveis abaixo em cache_hierarchy.h)
 void init_cache(void);
-bool check_cache(unsigned int address, char* current_instruction);
-void update_cache(unsigned int address, char* data);
-void print_cache_state(void);
-float calculate_cache_efficiency(int index);
+void free_cache(void);
+void cache_attach_memory(char* memory, size_t size);
+bool check_cache(int core_id, unsigned int address, char* current_instruction);
+int update_cache(int core_id, unsigned int address);
+int cache_write_allocate(int core_id, unsigned int address);
+int cache_find_line(int core_id, unsigned int address);
+void cache_drop_line(int core_id, int line);
+void cache_warm_block(unsigned int address);
+bool cache_invalidate_block(int core_id, unsigned int address);
+void cache_invalidate_range(unsigned int base_address, unsigned int size);
+int cache_load(int core_id, unsigned int pc, unsigned int address, char* data, int length);
+int cache_store(int core_id, unsigned int pc, unsigned int address, const char* data, int length);
+int cache_writeback_line(int core_id, int line);
+void cache_flush_dirty_lines(void);
+bool cache_read_byte(int core_id, unsigned int address, char* value);
+line_diagnostics* cache_line_diagnostics(int core_id, int line);
+void print_cache_state(int core_id);
+float calculate_cache_efficiency(int core_id, int index);
+
+// Residência por processo (escalonador cache-aware), mantida nos fills e evicções
+void cache_block_residency(unsigned int block, int delta);
+void cache_track_region(int pid, unsigned int base_address, unsigned int limit);
+void cache_untrack_region(int pid);
+float cache_region_resident_fraction(int pid);
 
 // Funções de análise
-int find_lru_entry(void);
+int find_victim_way(int core_id, unsigned int set);
 
-// Novas funções para prefetch
-void prefetch_block(unsigned int base_address, int distance);
-int estimate_loop_size(char* content, char* loop_start);
-void analyze_instruction_pattern(char* content, unsigned int address);
-void print_instruction_patterns(void);
+// Prefetch (prefetchers em prefetcher.h)
+bool prefetch_line(int core_id, unsigned int address, int source);
 void print_cache_statistics(void);
 void print_block_details(void);
 
-extern CacheEntry cache[CACHE_SIZE];
-extern CacheAccess access_history[MAX_ACCESS_HISTORY];
-extern int access_count;
+extern l1_cache cache[NUM_CORES];
 
 // Na lista de funções
 void set_cache_enabled(bool enabled);
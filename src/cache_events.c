@@ -0,0 +1,57 @@
+#include "cache_events.h"
+#include "cache.h"
+#include "cache_hierarchy.h"
+#include "cache_replacement.h"
+#include <stdio.h>
+
+cache_event_sink cache_event_handler = NULL;
+
+void set_cache_event_sink(cache_event_sink sink) {
+    cache_event_handler = sink;
+}
+
+// Saída detalhada de cada evento, como o simulador imprimia a cada acesso
+void print_cache_event(const cache_event* event) {
+    switch (event->type) {
+        case CACHE_EVENT_HIT:
+        case CACHE_EVENT_MISS:
+            printf("\n═══════════ Acesso à L1 (core %d) ═══════════", event->core_id);
+            printf("\n┌── Endereço: %u (tag %u, conjunto %u, offset %u)",
+                   event->address, CACHE_TAG(event->address), event->set,
+                   CACHE_OFFSET(event->address));
+            printf("\n├── Instrução: %s", event->instruction ? event->instruction : "-");
+            if (event->type == CACHE_EVENT_HIT) {
+                printf("\n├── Resultado: ✓ HIT%s", event->prefetched ? " (prefetched)" : "");
+                printf("\n├── Via: %d", event->way);
+                printf("\n└── Ganho: %.1f ciclos", average_miss_penalty());
+            } else {
+                printf("\n├── Resultado: ✗ MISS");
+                printf("\n└── Conjunto: %u", event->set);
+            }
+            printf("\n═════════════════════════════════════\n");
+            break;
+
+        case CACHE_EVENT_FILL:
+            printf("\n╔═══════════ Atualização de Bloco ═══════════╗");
+            printf("\n║ Core %d, endereço 0x%04X → Conjunto %u, via %d",
+                   event->core_id, event->address, event->set, event->way);
+            if (event->eviction) {
+                printf("\n║ ├── Conflito: bloco 0x%04X substituído (%s)",
+                       event->victim_address, current_replacement_policy()->name);
+            }
+            printf("\n║ └── Latência do miss: %d ciclos", event->latency);
+            printf("\n╚═════════════════════════════════════════════╝\n");
+            print_cache_state(event->core_id);
+            break;
+
+        case CACHE_EVENT_PREFETCH:
+            printf("\n[Prefetch] Core %d: bloco 0x%04X → conjunto %u, via %d (chega em %d ciclos)",
+                   event->core_id, event->address, event->set, event->way, event->latency);
+            break;
+
+        case CACHE_EVENT_WRITEBACK:
+            printf("\n[Writeback] Core %d: bloco 0x%04X volta à memória (%d ciclos)",
+                   event->core_id, event->address, event->latency);
+            break;
+    }
+}
@@ -0,0 +1,41 @@
+#ifndef CACHE_EVENTS_H
+#define CACHE_EVENTS_H
+
+#include <stdbool.h>
+
+// Eventos da L1 para relatórios opcionais. O caminho de acesso não imprime
+// nada: com sink registrado, cada evento chega a ele; sem sink, custo zero.
+typedef enum {
+    CACHE_EVENT_HIT,
+    CACHE_EVENT_MISS,
+    CACHE_EVENT_FILL,       // Bloco de demanda copiado para a via (latência do miss)
+    CACHE_EVENT_PREFETCH,   // Bloco trazido por prefetcher
+    CACHE_EVENT_WRITEBACK   // Bytes sujos devolvidos à memória
+} CacheEventType;
+
+typedef struct {
+    CacheEventType type;
+    int core_id;
+    unsigned int address;
+    unsigned int set;
+    int way;
+    int latency;                  // FILL/PREFETCH/WRITEBACK: ciclos
+    bool prefetched;              // HIT em linha trazida por prefetch
+    bool eviction;                // FILL: a via tinha outro bloco válido
+    unsigned int victim_address;  // FILL com evicção: bloco substituído
+    const char* instruction;      // HIT/MISS de busca: texto da instrução
+} cache_event;
+
+typedef void (*cache_event_sink)(const cache_event* event);
+
+// Liga a saída detalhada por acesso (sink de depuração)
+#ifndef CACHE_EVENT_TRACE
+#define CACHE_EVENT_TRACE false
+#endif
+
+extern cache_event_sink cache_event_handler;
+
+void set_cache_event_sink(cache_event_sink sink);
+void print_cache_event(const cache_event* event);
+
+#endif
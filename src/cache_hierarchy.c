@@ -0,0 +1,264 @@
+#include "cache_hierarchy.h"
+#include <stdio.h>
+#include <string.h>
+
+static unsigned int l2_blocks[NUM_CORES][L2_SIZE];
+static bool l2_valid[NUM_CORES][L2_SIZE];
+static repl_set_state l2_repl[NUM_CORES][L2_SIZE / L2_WAYS];
+static cache_level l2[NUM_CORES];
+
+static unsigned int llc_blocks[LLC_SIZE];
+static bool llc_valid[LLC_SIZE];
+static repl_set_state llc_repl[LLC_SIZE / LLC_WAYS];
+static cache_level llc;
+
+// A LLC é compartilhada entre os cores
+static pthread_mutex_t llc_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static long miss_cycles = 0;     // Latência acumulada dos misses de L1
+static int l1_misses = 0;
+static int memory_reads = 0;
+static int prefetch_reads = 0;   // Buscas dos prefetchers da L1
+
+static const char* inclusion_names[] = { "Inclusiva", "Exclusiva", "NINE" };
+
+static void init_level(cache_level* level, const char* name, int size, int ways,
+                       int latency, unsigned int* blocks, bool* valid,
+                       repl_set_state* repl) {
+    level->name = name;
+    level->sets = size / ways;
+    level->ways = ways;
+    level->latency = latency;
+    level->blocks = blocks;
+    level->valid = valid;
+    level->repl = repl;
+    level->hits = level->misses = level->evictions = level->back_invalidations = 0;
+
+    memset(valid, 0, size * sizeof(bool));
+    for (int set = 0; set < level->sets; set++) {
+        replacement_init_set(&repl[set], ways);
+    }
+}
+
+void reset_cache_hierarchy(void) {
+    for (int core = 0; core < NUM_CORES; core++) {
+        init_level(&l2[core], "L2", L2_SIZE, L2_WAYS, L2_LATENCY,
+                   l2_blocks[core], l2_valid[core], l2_repl[core]);
+    }
+    init_level(&llc, "LLC", LLC_SIZE, LLC_WAYS, LLC_LATENCY,
+               llc_blocks, llc_valid, llc_repl);
+    miss_cycles = 0;
+    l1_misses = 0;
+    memory_reads = 0;
+    prefetch_reads = 0;
+}
+
+// Índice da linha com o bloco, ou -1
+static int level_find(cache_level* level, unsigned int block) {
+    int base = (block % level->sets) * level->ways;
+    for (int way = 0; way < level->ways; way++) {
+        if (level->valid[base + way] && level->blocks[base + way] == block) {
+            return base + way;
+        }
+    }
+    return -1;
+}
+
+static bool level_lookup(cache_level* level, unsigned int block) {
+    int line = level_find(level, block);
+    if (line < 0) {
+        level->misses++;
+        return false;
+    }
+    level->hits++;
+    current_replacement_policy()->on_hit(&level->repl[line / level->ways],
+                                         line % level->ways);
+    return true;
+}
+
+// Insere o bloco; devolve true e o bloco removido se houve evicção
+static bool level_insert(cache_level* level, unsigned int block, unsigned int* evicted) {
+    if (level_find(level, block) >= 0) return false;
+
+    int set = block % level->sets;
+    int base = set * level->ways;
+    int way = -1;
+    for (int w = 0; w < level->ways && way < 0; w++) {
+        if (!level->valid[base + w]) way = w;
+    }
+
+    bool eviction = false;
+    if (way < 0) {
+        way = current_replacement_policy()->select_victim(&level->repl[set]);
+        *evicted = level->blocks[base + way];
+        level->evictions++;
+        eviction = true;
+        cache_block_residency(*evicted, -1);
+    }
+
+    level->blocks[base + way] = block;
+    level->valid[base + way] = true;
+    cache_block_residency(block, 1);
+    current_replacement_policy()->on_fill(&level->repl[set], way);
+    return eviction;
+}
+
+static bool level_remove(cache_level* level, unsigned int block) {
+    int line = level_find(level, block);
+    if (line < 0) return false;
+    level->valid[line] = false;
+    cache_block_residency(block, -1);
+    return true;
+}
+
+// Inclusão: bloco que sai de um nível sai também dos níveis acima
+static void back_invalidate_from_l2(int core_id, unsigned int block) {
+    if (cache_invalidate_block(core_id, block * BLOCK_SIZE)) {
+        l2[core_id].back_invalidations++;
+    }
+}
+
+static void back_invalidate_from_llc(unsigned int block) {
+    for (int core = 0; core < NUM_CORES; core++) {
+        bool removed = cache_invalidate_block(core, block * BLOCK_SIZE);
+        if (L2_ENABLED) removed |= level_remove(&l2[core], block);
+        if (removed) llc.back_invalidations++;
+    }
+}
+
+static void fill_llc(unsigned int block) {
+    unsigned int evicted;
+    if (level_insert(&llc, block, &evicted) && INCLUSION_POLICY == INCLUSION_INCLUSIVE) {
+        back_invalidate_from_llc(evicted);
+    }
+}
+
+static void fill_l2(int core_id, unsigned int block) {
+    unsigned int evicted;
+    if (!level_insert(&l2[core_id], block, &evicted)) return;
+
+    if (INCLUSION_POLICY == INCLUSION_INCLUSIVE) {
+        back_invalidate_from_l2(core_id, evicted);
+    } else if (INCLUSION_POLICY == INCLUSION_EXCLUSIVE) {
+        pthread_mutex_lock(&llc_mutex);
+        fill_llc(evicted);
+        pthread_mutex_unlock(&llc_mutex);
+    }
+}
+
+static int account_miss(int latency) {
+    miss_cycles += latency;
+    l1_misses++;
+    return latency;
+}
+
+// Percorre L2 → LLC → memória atrás do bloco. Devolve os ciclos além da L1.
+static int fetch_below_l1(int core_id, unsigned int address) {
+    unsigned int block = address / BLOCK_SIZE;
+    int latency = 0;
+
+    if (L2_ENABLED) {
+        latency += L2_LATENCY;
+        if (level_lookup(&l2[core_id], block)) {
+            // Exclusiva: o bloco sobe para a L1 e deixa a L2
+            if (INCLUSION_POLICY == INCLUSION_EXCLUSIVE) level_remove(&l2[core_id], block);
+            return latency;
+        }
+    }
+
+    pthread_mutex_lock(&llc_mutex);
+    latency += LLC_LATENCY;
+    bool llc_hit = level_lookup(&llc, block);
+    if (!llc_hit) {
+        latency += MEMORY_LATENCY;
+        memory_reads++;
+    }
+
+    if (INCLUSION_POLICY == INCLUSION_EXCLUSIVE) {
+        if (llc_hit) level_remove(&llc, block);
+    } else if (!llc_hit) {
+        fill_llc(block);
+    }
+    pthread_mutex_unlock(&llc_mutex);
+
+    if (L2_ENABLED && INCLUSION_POLICY != INCLUSION_EXCLUSIVE) {
+        fill_l2(core_id, block);
+    }
+    return latency;
+}
+
+// Miss de demanda na L1: a latência entra no stall do core
+int hierarchy_fetch(int core_id, unsigned int address) {
+    return account_miss(fetch_below_l1(core_id, address));
+}
+
+// Prefetch para a L1: mesmo caminho, sem contar como miss de demanda.
+// Devolve em quantos ciclos o bloco chega.
+int hierarchy_prefetch(int core_id, unsigned int address) {
+    prefetch_reads++;
+    return fetch_below_l1(core_id, address);
+}
+
+// Exclusiva: vítima da L1 desce para o próximo nível
+void hierarchy_l1_evicted(int core_id, unsigned int address) {
+    if (INCLUSION_POLICY != INCLUSION_EXCLUSIVE) return;
+
+    unsigned int block = address / BLOCK_SIZE;
+    if (L2_ENABLED) {
+        fill_l2(core_id, block);
+    } else {
+        pthread_mutex_lock(&llc_mutex);
+        fill_llc(block);
+        pthread_mutex_unlock(&llc_mutex);
+    }
+}
+
+// Traz o bloco para a LLC sem associá-lo a um core (aquecimento)
+void hierarchy_warm(unsigned int address) {
+    pthread_mutex_lock(&llc_mutex);
+    unsigned int block = address / BLOCK_SIZE;
+    if (level_find(&llc, block) < 0) {
+        memory_reads++;
+        fill_llc(block);
+    }
+    pthread_mutex_unlock(&llc_mutex);
+}
+
+float average_miss_penalty(void) {
+    return l1_misses > 0 ? (float)miss_cycles / l1_misses : (float)FULL_MISS_LATENCY;
+}
+
+long hierarchy_miss_cycles(void) {
+    return miss_cycles;
+}
+
+static void print_level(cache_level* level, int core_id) {
+    int accesses = level->hits + level->misses;
+    if (core_id >= 0) printf("\n║ %s (core %d)", level->name, core_id);
+    else printf("\n║ %s (compartilhada)", level->name);
+    printf("\n║ ├── Geometria: %d conjuntos x %d vias, %d ciclos",
+           level->sets, level->ways, level->latency);
+    printf("\n║ ├── Hits/Misses: %d/%d (%.1f%%)", level->hits, level->misses,
+           accesses > 0 ? (float)level->hits * 100 / accesses : 0.0f);
+    printf("\n║ └── Evicções: %d, invalidações por inclusão: %d",
+           level->evictions, level->back_invalidations);
+}
+
+void print_hierarchy_statistics(void) {
+    printf("\n\n╔═══════════ Hierarquia de Cache ═══════════╗");
+    printf("\n║ Inclusão: %s", inclusion_names[INCLUSION_POLICY]);
+    printf("\n║ Latências: L1 %d, L2 %s%d, LLC %d, memória %d ciclos",
+           L1_LATENCY, L2_ENABLED ? "" : "desligada/", L2_LATENCY,
+           LLC_LATENCY, MEMORY_LATENCY);
+    printf("\n╠═══════════════════════════════════════════╣");
+    for (int core = 0; L2_ENABLED && core < NUM_CORES; core++) {
+        if (l2[core].hits + l2[core].misses > 0) print_level(&l2[core], core);
+    }
+    print_level(&llc, -1);
+    printf("\n╠═══════════════════════════════════════════╣");
+    printf("\n║ Misses de L1: %d, buscas de prefetch: %d, leituras da memória: %d",
+           l1_misses, prefetch_reads, memory_reads);
+    printf("\n║ Ciclos de stall por miss: %ld (média %.1f)",
+           miss_cycles, average_miss_penalty());
+    printf("\n╚═══════════════════════════════════════════╝\n");
+}
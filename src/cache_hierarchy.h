@@ -0,0 +1,81 @@
+#ifndef CACHE_HIERARCHY_H
+#define CACHE_HIERARCHY_H
+
+#include "cache_replacement.h"
+#include <pthread.h>
+
+// Níveis abaixo da L1 privada (cache.c): L2 privada opcional por core e
+// LLC compartilhada. Tamanhos em linhas de BLOCK_SIZE bytes; latências
+// em ciclos somadas ao longo do caminho do miss.
+#define L1_LATENCY 1
+
+#ifndef L2_ENABLED
+#define L2_ENABLED 1
+#endif
+#ifndef L2_SIZE
+#define L2_SIZE 64
+#endif
+#ifndef L2_WAYS
+#define L2_WAYS 8
+#endif
+#ifndef L2_LATENCY
+#define L2_LATENCY 3
+#endif
+
+#ifndef LLC_SIZE
+#define LLC_SIZE 256
+#endif
+#ifndef LLC_WAYS
+#define LLC_WAYS 16
+#endif
+#ifndef LLC_LATENCY
+#define LLC_LATENCY 8
+#endif
+
+#ifndef MEMORY_LATENCY
+#define MEMORY_LATENCY 12
+#endif
+
+// Misses de L1 atrasam o core pela latência composta
+#ifndef CACHE_STALLS_ENABLED
+#define CACHE_STALLS_ENABLED true
+#endif
+
+// Miss em todos os níveis
+#define FULL_MISS_LATENCY (L2_ENABLED * L2_LATENCY + LLC_LATENCY + MEMORY_LATENCY)
+
+typedef enum {
+    INCLUSION_INCLUSIVE,  // Nível de baixo contém os de cima (evicção invalida acima)
+    INCLUSION_EXCLUSIVE,  // Bloco em um nível só; vítimas da L1 descem
+    INCLUSION_NINE        // Nem inclusiva nem exclusiva: preenche todos, sem invalidar
+} InclusionPolicy;
+
+#ifndef INCLUSION_POLICY
+#define INCLUSION_POLICY INCLUSION_NINE
+#endif
+
+// Nível guarda só números de bloco: os dados vêm da RAM para a L1
+typedef struct cache_level {
+    const char* name;
+    int sets;
+    int ways;
+    int latency;
+    unsigned int* blocks;   // sets * ways, via w do conjunto s em s * ways + w
+    bool* valid;
+    repl_set_state* repl;
+    int hits;
+    int misses;
+    int evictions;
+    int back_invalidations; // Cópias invalidadas acima por inclusão
+} cache_level;
+
+void reset_cache_hierarchy(void);
+int hierarchy_fetch(int core_id, unsigned int address);
+int hierarchy_prefetch(int core_id, unsigned int address);
+void hierarchy_l1_evicted(int core_id, unsigned int address);
+void hierarchy_warm(unsigned int address);
+float average_miss_penalty(void);
+long hierarchy_miss_cycles(void);
+void print_hierarchy_statistics(void);
+
+#endif
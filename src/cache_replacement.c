@@ -0,0 +1,241 @@
+#include "cache_replacement.h"
+#include "sim_random.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Sorteios do BRRIP e da substituição aleatória
+static sim_rng replacement_rng;
+
+// Buscas na ordem em que chegaram às L1 (core e endereço)
+typedef struct {
+    int core_id;
+    unsigned int address;
+} trace_entry;
+
+static trace_entry* fetch_trace = NULL;
+static int trace_count = 0;
+static int trace_capacity = 0;
+
+void replacement_seed(uint64_t seed) {
+    sim_rng_seed(&replacement_rng, seed);
+}
+
+void replacement_init_set(repl_set_state* set, int ways) {
+    set->ways = ways;
+    for (int way = 0; way < ways; way++) {
+        set->age[way] = way;  // Pilha LRU sempre é uma permutação de 0..W-1
+        set->rrpv[way] = RRPV_MAX;
+        set->freq[way] = 0;
+    }
+    set->plru = 0;
+}
+
+// ── LRU: contadores de idade por conjunto ──
+
+static void lru_touch(repl_set_state* set, int way) {
+    for (int w = 0; w < set->ways; w++) {
+        if (set->age[w] < set->age[way]) set->age[w]++;
+    }
+    set->age[way] = 0;
+}
+
+static int lru_victim(repl_set_state* set) {
+    int victim = 0;
+    for (int way = 1; way < set->ways; way++) {
+        if (set->age[way] > set->age[victim]) victim = way;
+    }
+    return victim;
+}
+
+// ── Tree-PLRU: nó i aponta para a metade que deve ser substituída ──
+
+static void plru_touch(repl_set_state* set, int way) {
+    int node = 1;
+    for (int half = set->ways / 2; half >= 1; half /= 2) {
+        int right = (way & half) != 0;
+        // Aponta para o lado oposto ao acessado
+        if (right) set->plru &= ~(1u << node);
+        else set->plru |= 1u << node;
+        node = node * 2 + right;
+    }
+}
+
+static int plru_victim(repl_set_state* set) {
+    int node = 1, way = 0;
+    for (int half = set->ways / 2; half >= 1; half /= 2) {
+        int right = (set->plru >> node) & 1;
+        if (right) way |= half;
+        node = node * 2 + right;
+    }
+    return way;
+}
+
+// ── RRIP: hit promove para 0, vítima é a primeira via com RRPV_MAX ──
+
+static void rrip_hit(repl_set_state* set, int way) {
+    set->rrpv[way] = 0;
+}
+
+static void srrip_fill(repl_set_state* set, int way) {
+    set->rrpv[way] = RRPV_MAX - 1;
+}
+
+// Bimodal: quase sempre prevê re-referência distante (resiste a varreduras)
+static void brrip_fill(repl_set_state* set, int way) {
+    set->rrpv[way] = sim_rng_range(&replacement_rng, BRRIP_LONG_CHANCE) == 0 ?
+                     RRPV_MAX - 1 : RRPV_MAX;
+}
+
+static int rrip_victim(repl_set_state* set) {
+    for (;;) {
+        for (int way = 0; way < set->ways; way++) {
+            if (set->rrpv[way] == RRPV_MAX) return way;
+        }
+        for (int way = 0; way < set->ways; way++) {
+            set->rrpv[way]++;
+        }
+    }
+}
+
+// ── LFU: menor contagem desde o fill, empate na via de menor índice ──
+
+static void lfu_hit(repl_set_state* set, int way) {
+    if (set->freq[way] < UINT16_MAX) set->freq[way]++;
+}
+
+static void lfu_fill(repl_set_state* set, int way) {
+    set->freq[way] = 1;
+}
+
+static int lfu_victim(repl_set_state* set) {
+    int victim = 0;
+    for (int way = 1; way < set->ways; way++) {
+        if (set->freq[way] < set->freq[victim]) victim = way;
+    }
+    return victim;
+}
+
+// ── Aleatória ──
+
+static void no_update(repl_set_state* set __attribute__((unused)),
+                      int way __attribute__((unused))) {
+}
+
+static int random_victim(repl_set_state* set) {
+    return sim_rng_range(&replacement_rng, set->ways);
+}
+
+static const ReplacementPolicy replacement_policies[REPL_COUNT] = {
+    { REPL_LRU,    "LRU",    lru_touch,  lru_touch,   lru_victim    },
+    { REPL_PLRU,   "PLRU",   plru_touch, plru_touch,  plru_victim   },
+    { REPL_SRRIP,  "SRRIP",  rrip_hit,   srrip_fill,  rrip_victim   },
+    { REPL_BRRIP,  "BRRIP",  rrip_hit,   brrip_fill,  rrip_victim   },
+    { REPL_LFU,    "LFU",    lfu_hit,    lfu_fill,    lfu_victim    },
+    { REPL_RANDOM, "Random", no_update,  no_update,   random_victim }
+};
+
+const ReplacementPolicy* get_replacement_policy(ReplacementType type) {
+    if (type < 0 || type >= REPL_COUNT) return &replacement_policies[REPL_LRU];
+    return &replacement_policies[type];
+}
+
+void select_replacement_policy(void) {
+    printf("\n╔════════ Política de Substituição da Cache ════════╗");
+    for (int i = 0; i < REPL_COUNT; i++) {
+        printf("\n║  %d. %-46s║", i + 1, replacement_policies[i].name);
+    }
+    printf("\n╚═══════════════════════════════════════════════════╝");
+    printf("\nEscolha (1-%d): ", REPL_COUNT);
+
+    int choice = 0;
+    if (scanf("%d", &choice) != 1 || choice < 1 || choice > REPL_COUNT) {
+        printf("\n[Cache] Opção inválida, usando LRU");
+        choice = REPL_LRU + 1;
+    }
+    set_replacement_policy((ReplacementType)(choice - 1));
+    printf("\n[Cache] Substituição: %s", current_replacement_policy()->name);
+}
+
+void replacement_trace_record(int core_id, unsigned int address) {
+    if (trace_count == trace_capacity) {
+        int capacity = trace_capacity ? trace_capacity * 2 : 256;
+        trace_entry* grown = realloc(fetch_trace, capacity * sizeof(*grown));
+        if (!grown) return;
+        fetch_trace = grown;
+        trace_capacity = capacity;
+    }
+    fetch_trace[trace_count].core_id = core_id;
+    fetch_trace[trace_count].address = address;
+    trace_count++;
+}
+
+void free_replacement_trace(void) {
+    free(fetch_trace);
+    fetch_trace = NULL;
+    trace_count = trace_capacity = 0;
+}
+
+// Repete o trace em L1 sombra com a mesma geometria (só demanda, sem prefetch)
+static int replay_trace(const ReplacementPolicy* policy) {
+    static repl_set_state sets[NUM_CORES][CACHE_SETS];
+    static unsigned int tags[NUM_CORES][CACHE_SIZE];
+    static bool valid[NUM_CORES][CACHE_SIZE];
+    int hits = 0;
+
+    for (int c = 0; c < NUM_CORES; c++) {
+        for (int s = 0; s < CACHE_SETS; s++) replacement_init_set(&sets[c][s], CACHE_WAYS);
+    }
+    memset(valid, 0, sizeof(valid));
+    replacement_seed(DEFAULT_SEED);
+
+    for (int i = 0; i < trace_count; i++) {
+        int core = fetch_trace[i].core_id;
+        unsigned int set = CACHE_INDEX(fetch_trace[i].address);
+        unsigned int tag = CACHE_TAG(fetch_trace[i].address);
+        unsigned int* set_tags = &tags[core][set * CACHE_WAYS];
+        bool* set_valid = &valid[core][set * CACHE_WAYS];
+        repl_set_state* state = &sets[core][set];
+
+        int way = -1;
+        for (int w = 0; w < CACHE_WAYS; w++) {
+            if (set_valid[w] && set_tags[w] == tag) {
+                way = w;
+                break;
+            }
+        }
+        if (way >= 0) {
+            hits++;
+            policy->on_hit(state, way);
+            continue;
+        }
+
+        for (int w = 0; w < CACHE_WAYS && way < 0; w++) {
+            if (!set_valid[w]) way = w;
+        }
+        if (way < 0) way = policy->select_victim(state);
+
+        set_tags[way] = tag;
+        set_valid[way] = true;
+        policy->on_fill(state, way);
+    }
+    return hits;
+}
+
+void print_replacement_comparison(void) {
+    if (trace_count == 0) return;
+
+    printf("\n\n╔═══════════ Políticas de Substituição ═══════════╗");
+    printf("\n║ Trace: %-5d buscas, L1 de %d conjunto(s) x %d vias ║",
+           trace_count, CACHE_SETS, CACHE_WAYS);
+    printf("\n╠═══════════════════════════════════════════════╣");
+    for (int i = 0; i < REPL_COUNT; i++) {
+        const ReplacementPolicy* policy = &replacement_policies[i];
+        int hits = replay_trace(policy);
+        printf("\n║ %c %-7s Hits: %-5d Misses: %-5d %5.1f%% ║",
+               policy == current_replacement_policy() ? '*' : ' ',
+               policy->name, hits, trace_count - hits,
+               (float)hits * 100 / trace_count);
+    }
+    printf("\n╚═══════════════════════════════════════════════╝\n");
+}
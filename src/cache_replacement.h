@@ -0,0 +1,56 @@
+#ifndef CACHE_REPLACEMENT_H
+#define CACHE_REPLACEMENT_H
+
+#include "cache.h"
+#include <stdint.h>
+
+// Configuração do RRIP
+#define RRPV_MAX 3            // Contador de 2 bits
+#define BRRIP_LONG_CHANCE 32  // BRRIP insere com RRPV_MAX-1 em 1 de cada N fills
+
+#define REPL_MAX_WAYS 16      // Maior associatividade entre os níveis da hierarquia
+
+// Estado de substituição de um conjunto; cada política usa os seus campos
+typedef struct repl_set_state {
+    uint8_t ways;                  // Associatividade do nível (potência de 2)
+    uint8_t age[REPL_MAX_WAYS];    // LRU: posição na pilha (0 = mais recente)
+    uint8_t rrpv[REPL_MAX_WAYS];   // RRIP: distância de re-referência prevista
+    uint16_t freq[REPL_MAX_WAYS];  // LFU: acessos desde o fill
+    uint32_t plru;                 // PLRU: um bit por nó interno da árvore
+} repl_set_state;
+
+typedef enum {
+    REPL_LRU,
+    REPL_PLRU,
+    REPL_SRRIP,
+    REPL_BRRIP,
+    REPL_LFU,
+    REPL_RANDOM,
+    REPL_COUNT
+} ReplacementType;
+
+// Interface de substituição, no mesmo formato da Policy do escalonador.
+// select_victim só é chamada com todas as vias do conjunto válidas.
+typedef struct ReplacementPolicy {
+    ReplacementType type;
+    const char* name;
+    void (*on_hit)(repl_set_state* set, int way);
+    void (*on_fill)(repl_set_state* set, int way);
+    int (*select_victim)(repl_set_state* set);
+} ReplacementPolicy;
+
+void replacement_init_set(repl_set_state* set, int ways);
+void replacement_seed(uint64_t seed);
+const ReplacementPolicy* get_replacement_policy(ReplacementType type);
+
+// Política ativa da cache (cache.c)
+void set_replacement_policy(ReplacementType type);
+const ReplacementPolicy* current_replacement_policy(void);
+void select_replacement_policy(void);
+
+// Trace de buscas por core, repetido contra cada política no relatório final
+void replacement_trace_record(int core_id, unsigned int address);
+void print_replacement_comparison(void);
+void free_replacement_trace(void);
+
+#endif
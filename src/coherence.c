@@ -0,0 +1,324 @@
+#include "coherence.h"
+#include "cache_hierarchy.h"
+#include <stdio.h>
+#include <string.h>
+
+#define DIRECTORY_SETS (DIRECTORY_ENTRIES / DIRECTORY_WAYS)
+
+static int bus_transactions[BUS_TRANSACTION_TYPES];
+static long snoop_lookups = 0;   // Tags consultadas pelos outros cores a cada broadcast
+static int invalidations = 0;
+static int upgrades = 0;         // S → M via BusUpgr
+static int silent_upgrades = 0;  // E → M sem barramento
+static block_sharing sharing[NUM_BLOCKS + 1];
+
+// Diretório esparso (set-associativo), substituição pela política da cache
+static directory_entry directory[DIRECTORY_ENTRIES];
+static repl_set_state directory_repl[DIRECTORY_SETS];
+static long directory_messages = 0;   // Pedidos, encaminhamentos, invalidações, acks e respostas
+static int directory_lookups = 0;
+static int directory_evictions = 0;
+static int directory_invalidations = 0; // Cópias em L1 removidas por evicção no diretório
+static int broadcast_invalidations = 0; // Ponteiros limitados esgotados
+static long indirection_cycles = 0;
+
+static const char* bus_names[BUS_TRANSACTION_TYPES] = { "BusRd", "BusRdX", "BusUpgr", "Flush" };
+
+void reset_coherence(void) {
+    memset(bus_transactions, 0, sizeof(bus_transactions));
+    memset(sharing, 0, sizeof(sharing));
+    snoop_lookups = 0;
+    invalidations = upgrades = silent_upgrades = 0;
+
+    memset(directory, 0, sizeof(directory));
+    for (int set = 0; set < DIRECTORY_SETS; set++) {
+        replacement_init_set(&directory_repl[set], DIRECTORY_WAYS);
+    }
+    directory_messages = 0;
+    directory_lookups = directory_evictions = 0;
+    directory_invalidations = broadcast_invalidations = 0;
+    indirection_cycles = 0;
+}
+
+static block_sharing* sharing_of(unsigned int address) {
+    unsigned int block = address / BLOCK_SIZE;
+    return &sharing[block <= NUM_BLOCKS ? block : NUM_BLOCKS];
+}
+
+static uint64_t core_bit(int core_id) {
+    return (uint64_t)1 << core_id;
+}
+
+void coherence_note_access(int core_id, unsigned int address, int length) {
+    sharing_of(address)->touched[core_id] |= CACHE_BYTE_MASK(CACHE_OFFSET(address), length);
+}
+
+// Invalida as cópias de `targets` (exceto o próprio core); compara os bytes
+// usados por cada um com os escritos para separar compartilhamento real de falso
+static void invalidate_copies(int core_id, unsigned int address, uint32_t written,
+                              uint64_t targets) {
+    block_sharing* block = sharing_of(address);
+
+    for (int core = 0; core < NUM_CORES; core++) {
+        if (core == core_id || !(targets & core_bit(core))) continue;
+        int line = cache_find_line(core, address);
+        if (line < 0) continue;
+
+        if (cache[core].mesi[line] == MESI_MODIFIED) {
+            bus_transactions[BUS_FLUSH]++;
+            cache_writeback_line(core, line);
+        }
+        cache_drop_line(core, line);
+        invalidations++;
+        block->invalidations++;
+        if (block->touched[core] && !(block->touched[core] & written)) {
+            block->false_sharing++;
+        }
+        block->touched[core] = 0;
+    }
+}
+
+// ── Diretório ──
+
+static directory_entry* directory_find(unsigned int block) {
+    directory_entry* set = &directory[(block % DIRECTORY_SETS) * DIRECTORY_WAYS];
+    for (int way = 0; way < DIRECTORY_WAYS; way++) {
+        if (set[way].valid && set[way].block == block) return &set[way];
+    }
+    return NULL;
+}
+
+// Entrada do bloco; sem espaço no conjunto, a vítima tem as cópias invalidadas
+static directory_entry* directory_lookup(unsigned int block) {
+    unsigned int set_index = block % DIRECTORY_SETS;
+    directory_lookups++;
+    directory_entry* entry = directory_find(block);
+    if (entry) {
+        current_replacement_policy()->on_hit(&directory_repl[set_index],
+                                             entry - &directory[set_index * DIRECTORY_WAYS]);
+        return entry;
+    }
+
+    directory_entry* set = &directory[set_index * DIRECTORY_WAYS];
+    int way = -1;
+    for (int w = 0; w < DIRECTORY_WAYS && way < 0; w++) {
+        if (!set[w].valid) way = w;
+    }
+
+    if (way < 0) {
+        way = current_replacement_policy()->select_victim(&directory_repl[set_index]);
+        directory_entry victim = set[way];
+        set[way].valid = false;  // Desliga antes: a invalidação notifica o diretório
+        directory_evictions++;
+
+        for (int core = 0; core < NUM_CORES; core++) {
+            if ((victim.sharers & core_bit(core)) &&
+                cache_invalidate_block(core, victim.block * BLOCK_SIZE)) {
+                directory_messages += 2;  // Invalidação + ack
+                directory_invalidations++;
+            }
+        }
+    }
+
+    entry = &set[way];
+    entry->block = block;
+    entry->valid = true;
+    entry->overflow = false;
+    entry->owner = -1;
+    entry->sharers = 0;
+    current_replacement_policy()->on_fill(&directory_repl[set_index], way);
+    return entry;
+}
+
+static void directory_add_sharer(directory_entry* entry, int core_id) {
+    entry->sharers |= core_bit(core_id);
+    if (DIRECTORY_FORMAT == DIR_LIMITED_POINTERS &&
+        __builtin_popcountll(entry->sharers) > DIR_POINTERS) {
+        entry->overflow = true;
+    }
+}
+
+// Pedido de leitura ao home: encaminha ao dono E/M, que cai para S
+static MesiState directory_read(int core_id, unsigned int address, int* latency) {
+    directory_entry* entry = directory_lookup(address / BLOCK_SIZE);
+    int cycles = DIRECTORY_LATENCY;
+    directory_messages += 2;  // Pedido + resposta
+
+    if (entry->owner >= 0 && entry->owner != core_id) {
+        int line = cache_find_line(entry->owner, address);
+        if (line >= 0) {
+            if (cache[entry->owner].mesi[line] == MESI_MODIFIED) {
+                bus_transactions[BUS_FLUSH]++;
+                cache_writeback_line(entry->owner, line);
+            }
+            cache[entry->owner].mesi[line] = MESI_SHARED;
+        }
+        directory_messages += 2;  // Encaminhamento + dado do dono
+        cycles += DIRECTORY_HOP_LATENCY;
+    }
+    entry->owner = -1;
+
+    bool shared = (entry->sharers & ~core_bit(core_id)) != 0;
+    directory_add_sharer(entry, core_id);
+    if (!shared) entry->owner = core_id;
+
+    indirection_cycles += cycles;
+    *latency += cycles;
+    return shared ? MESI_SHARED : MESI_EXCLUSIVE;
+}
+
+// Pedido de posse ao home: invalida os compartilhadores (ou todos, se estourou)
+static int directory_write(int core_id, unsigned int address, uint32_t written) {
+    directory_entry* entry = directory_lookup(address / BLOCK_SIZE);
+    int cycles = DIRECTORY_LATENCY;
+    directory_messages += 2;  // Pedido + resposta
+
+    uint64_t others = entry->sharers & ~core_bit(core_id);
+    if (others) {
+        int targets = __builtin_popcountll(others);
+        if (entry->overflow) {
+            others = ~core_bit(core_id);
+            targets = NUM_CORES - 1;
+            broadcast_invalidations++;
+        }
+        directory_messages += 2 * targets;  // Invalidações + acks
+        cycles += DIRECTORY_HOP_LATENCY;
+        invalidate_copies(core_id, address, written, others);
+    }
+
+    entry->sharers = core_bit(core_id);
+    entry->owner = core_id;
+    entry->overflow = false;
+
+    indirection_cycles += cycles;
+    return cycles;
+}
+
+// ── Snooping ──
+
+// BusRd ocupa o barramento; um dono M ainda põe o bloco nele (Flush)
+// antes de a cópia chegar
+static MesiState snoop_read(int core_id, unsigned int address, int* latency) {
+    bus_transactions[BUS_RD]++;
+    snoop_lookups += NUM_CORES - 1;
+    *latency += BUS_LATENCY;
+
+    bool shared = false;
+    for (int core = 0; core < NUM_CORES; core++) {
+        if (core == core_id) continue;
+        int line = cache_find_line(core, address);
+        if (line < 0) continue;
+
+        if (cache[core].mesi[line] == MESI_MODIFIED) {
+            bus_transactions[BUS_FLUSH]++;
+            cache_writeback_line(core, line);
+            *latency += BUS_LATENCY;
+        }
+        cache[core].mesi[line] = MESI_SHARED;
+        shared = true;
+    }
+    return shared ? MESI_SHARED : MESI_EXCLUSIVE;
+}
+
+static int snoop_write(int core_id, unsigned int address, uint32_t written, BusTransaction type) {
+    bus_transactions[type]++;
+    snoop_lookups += NUM_CORES - 1;
+    invalidate_copies(core_id, address, written, UINT64_MAX);
+    return BUS_LATENCY;
+}
+
+// Fill de leitura: E se nenhum outro core tem o bloco, senão S
+MesiState coherence_read_fill(int core_id, unsigned int address, int* latency) {
+    if (COHERENCE_MODE == COHERENCE_DIRECTORY) {
+        return directory_read(core_id, address, latency);
+    }
+    return snoop_read(core_id, address, latency);
+}
+
+void coherence_evicted(int core_id, unsigned int address) {
+    sharing_of(address)->touched[core_id] = 0;
+
+    if (COHERENCE_MODE != COHERENCE_DIRECTORY) return;
+
+    // Aviso de evicção mantém o vetor de compartilhadores exato
+    directory_entry* entry = directory_find(address / BLOCK_SIZE);
+    if (!entry) return;
+    directory_messages++;
+    entry->sharers &= ~core_bit(core_id);
+    if (entry->owner == core_id) entry->owner = -1;
+    if (!entry->sharers) entry->valid = false;
+}
+
+// STORE do core em um bloco: pede posse (BusRdX no miss, BusUpgr em S) e
+// deixa a linha em M. Sem `allocate`, o miss só invalida as outras cópias e
+// a escrita segue para a memória. Devolve os ciclos de stall.
+int coherence_write(int core_id, unsigned int address, uint32_t written, bool allocate) {
+    int latency = 0;
+    int line = cache_find_line(core_id, address);
+    MesiState state = line >= 0 ? cache[core_id].mesi[line] : MESI_INVALID;
+
+    if (line < 0 || state == MESI_SHARED) {
+        BusTransaction type = line >= 0 ? BUS_UPGR : BUS_RDX;
+        if (line >= 0) upgrades++;
+
+        latency += COHERENCE_MODE == COHERENCE_DIRECTORY ?
+                   directory_write(core_id, address, written) :
+                   snoop_write(core_id, address, written, type);
+        if (line < 0 && allocate) {
+            latency += cache_write_allocate(core_id, address);
+            line = cache_find_line(core_id, address);
+        }
+        // Sem cópia local, o diretório não guarda este core como dono
+        if (line < 0 && COHERENCE_MODE == COHERENCE_DIRECTORY) {
+            coherence_evicted(core_id, address);
+        }
+    } else if (state == MESI_EXCLUSIVE) {
+        silent_upgrades++;
+    }
+
+    if (line >= 0) cache[core_id].mesi[line] = MESI_MODIFIED;
+    sharing_of(address)->touched[core_id] |= written;
+    return latency;
+}
+
+void print_coherence_statistics(void) {
+    if (COHERENCE_MODE == COHERENCE_DIRECTORY) {
+        printf("\n\n╔═══════════ Coerência MESI (diretório) ═══════════╗");
+        printf("\n║ Formato: %s, %d entradas x %d vias, %d cores",
+               DIRECTORY_FORMAT == DIR_BITVECTOR ? "vetor de bits" : "ponteiros limitados",
+               DIRECTORY_SETS, DIRECTORY_WAYS, NUM_CORES);
+        printf("\n║ Mensagens ponto a ponto: %ld", directory_messages);
+        printf("\n║ ├── Consultas ao diretório: %d", directory_lookups);
+        printf("\n║ ├── Evicções no diretório: %d (cópias invalidadas: %d)",
+               directory_evictions, directory_invalidations);
+        printf("\n║ ├── Invalidações por broadcast: %d", broadcast_invalidations);
+        printf("\n║ └── Ciclos de indireção: %ld", indirection_cycles);
+    } else {
+        int total = 0;
+        for (int i = 0; i < BUS_TRANSACTION_TYPES; i++) total += bus_transactions[i];
+
+        printf("\n\n╔═══════════ Coerência MESI (snooping) ═══════════╗");
+        printf("\n║ Transações no barramento: %d", total);
+        for (int i = 0; i < BUS_TRANSACTION_TYPES; i++) {
+            printf("\n║ %s %-8s %d", i == BUS_TRANSACTION_TYPES - 1 ? "└──" : "├──",
+                   bus_names[i], bus_transactions[i]);
+        }
+        printf("\n║ Consultas de snoop nos outros cores: %ld", snoop_lookups);
+    }
+    printf("\n║ Invalidações: %d", invalidations);
+    printf("\n║ Upgrades S→M: %d (E→M silenciosos: %d)", upgrades, silent_upgrades);
+
+    bool header = false;
+    for (int block = 0; block <= NUM_BLOCKS; block++) {
+        if (sharing[block].invalidations == 0) continue;
+        if (!header) {
+            printf("\n╠═══════════════════════════════════════════════╣");
+            printf("\n║ Blocos com invalidações");
+            header = true;
+        }
+        printf("\n║ ├── 0x%04X: %d invalidações, %d por compartilhamento falso",
+               block * BLOCK_SIZE, sharing[block].invalidations,
+               sharing[block].false_sharing);
+    }
+    printf("\n╚═══════════════════════════════════════════════╝\n");
+}
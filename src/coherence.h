@@ -0,0 +1,76 @@
+#ifndef COHERENCE_H
+#define COHERENCE_H
+
+#include "cache.h"
+#include <stdint.h>
+
+// Coerência MESI entre as L1 privadas, por snooping em barramento ou por
+// diretório esparso junto à LLC. O protocolo controla as cópias; quando a
+// RAM recebe os dados depende da política de escrita (cache.h).
+#define BUS_LATENCY 2              // Ciclos de uma transação no barramento
+#define NUM_BLOCKS (NUM_MEMORY / BLOCK_SIZE)
+
+typedef enum {
+    COHERENCE_SNOOPING,
+    COHERENCE_DIRECTORY
+} CoherenceMode;
+
+#ifndef COHERENCE_MODE
+#define COHERENCE_MODE COHERENCE_SNOOPING
+#endif
+
+// Diretório esparso: cobre só os blocos presentes em alguma L1
+#ifndef DIRECTORY_ENTRIES
+#define DIRECTORY_ENTRIES 64
+#endif
+#ifndef DIRECTORY_WAYS
+#define DIRECTORY_WAYS 4
+#endif
+#define DIRECTORY_LATENCY 3        // Consulta ao nó home (indireção)
+#define DIRECTORY_HOP_LATENCY 2    // Encaminhamento ao dono / invalidações
+
+typedef enum {
+    DIR_BITVECTOR,        // Um bit por core
+    DIR_LIMITED_POINTERS  // DIR_POINTERS identidades; acima disso, broadcast
+} DirectoryFormat;
+
+#ifndef DIRECTORY_FORMAT
+#define DIRECTORY_FORMAT DIR_BITVECTOR
+#endif
+#define DIR_POINTERS 4
+
+#if NUM_CORES > 64
+#error "Vetor de compartilhadores do diretório comporta até 64 cores"
+#endif
+
+typedef enum {
+    BUS_RD,     // Leitura: cópias E/M dos outros caem para S
+    BUS_RDX,    // Leitura para escrita: invalida as outras cópias
+    BUS_UPGR,   // S → M sem buscar o bloco: invalida as outras cópias
+    BUS_FLUSH,  // Dono M devolve o bloco ao ser observado
+    BUS_TRANSACTION_TYPES
+} BusTransaction;
+
+typedef struct {
+    unsigned int block;
+    bool valid;
+    bool overflow;      // Ponteiros esgotados: próximas invalidações por broadcast
+    int owner;          // Core com a linha em E/M, -1 se nenhum
+    uint64_t sharers;   // Um bit por core com cópia
+} directory_entry;
+
+// Estatísticas por bloco para achar compartilhamento falso
+typedef struct {
+    uint32_t touched[NUM_CORES];  // Bytes do bloco usados por core desde o fill
+    int invalidations;
+    int false_sharing;            // Invalidações sem byte em comum com a escrita
+} block_sharing;
+
+void reset_coherence(void);
+MesiState coherence_read_fill(int core_id, unsigned int address, int* latency);
+void coherence_note_access(int core_id, unsigned int address, int length);
+void coherence_evicted(int core_id, unsigned int address);
+int coherence_write(int core_id, unsigned int address, uint32_t written, bool allocate);
+void print_coherence_statistics(void);
+
+#endif
@@ -2,8 +2,10 @@
 #define COMMON_TYPES_H
 
 // Definições globais
-#define MAX_PROCESSES 5
-#define NUM_CORES 4
+#define INITIAL_PROCESS_CAPACITY 8  // Tabelas de processos crescem sob demanda
+#ifndef NUM_CORES
+#define NUM_CORES 4                 // Sobrescrito por -DNUM_CORES (até 64)
+#endif
 #define NUM_REGISTERS 32
 #define NUM_MEMORY 1024
 
@@ -64,6 +66,15 @@ typedef struct instruction_pipe {
     ram* mem_ram;
 } instruction_pipe;
 
+// Assinatura do programa calculada uma vez na carga (política cache-aware)
+#define SIGNATURE_PREFIX 5   // Instruções iniciais comparadas par a par
+typedef struct instruction_signature {
+    type_of_instruction prefix_types[SIGNATURE_PREFIX];
+    unsigned int prefix_hashes[SIGNATURE_PREFIX];
+    int prefix_length;
+    unsigned short type_histogram[INVALID + 1];
+} instruction_signature;
+
 typedef struct program {
     char* name;          
     char* instructions;  
@@ -84,6 +84,10 @@ void init_cpu(cpu* cpu, ram* memory_ram) {
         cpu->core[i].is_available = true;
         cpu->core[i].quantum_remaining = 0;
         cpu->core[i].running = true;
+        cpu->core[i].last_pid = -1;
+        cpu->core[i].stall_cycles = 0;
+        cpu->core[i].dirty_registers = 0;
+        cpu->core[i].loaded_version = 0;
         pthread_mutex_init(&cpu->core[i].mutex, NULL);
         printf("\n[CPU Init] Core %d inicializado", i);
 
@@ -177,7 +181,30 @@ void release_core(cpu* cpu, int core_id) {
     
     // Salvar estado final do processo
     if (current_core->current_process) {
-        save_context(current_core->current_process, current_core);
+        PCB* process = current_core->current_process;
+
+        // Drenagem do pipeline + escrita dos registradores sujos
+        int cost = PIPELINE_DRAIN_PENALTY;
+        if (process->state != FINISHED) {
+            int dirty = __builtin_popcount(current_core->dirty_registers);
+            cost += (dirty + REGISTERS_PER_CYCLE - 1) / REGISTERS_PER_CYCLE;
+            if (current_core->arch_state) current_core->arch_state->registers_saved += dirty;
+        }
+        charge_context_switch(current_core, cost);
+
+        save_context(process, current_core);
+        current_core->last_pid = process->pid;
+
+        if (cpu->process_manager) {
+            quantum_tuner* tuner = &cpu->process_manager->tuner;
+            tuner->burst_cycles += current_core->current_process->current_burst;
+            tuner->bursts++;
+            // Troca forçada: o processo volta à fila em vez de terminar ou bloquear
+            if (process->preempted) {
+                tuner->switches++;
+                if (CONTEXT_SWITCH_COST_ENABLED) tuner->switch_cycles += cost;
+            }
+        }
     }
     
     // Resetar o core
@@ -189,6 +216,16 @@ void release_core(cpu* cpu, int core_id) {
     //printf("\n[Core %d] Core liberado", core_id);
 }
 
+// Cobra o custo de uma troca como stall do core
+void charge_context_switch(core* current_core, int cycles) {
+    if (!current_core || !CONTEXT_SWITCH_COST_ENABLED || cycles <= 0) return;
+
+    current_core->stall_cycles += cycles;
+    if (current_core->arch_state) {
+        current_core->arch_state->switch_cost_cycles += cycles;
+    }
+}
+
 core* get_current_core(cpu* cpu) {
     if (!cpu) return NULL;
     
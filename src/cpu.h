@@ -7,9 +7,26 @@
 #include "pcb.h"
 #include "architecture_state.h"
 
-#define NUM_CORES 4
 #define NUM_REGISTERS 32
 
+// Custo de afinidade (ciclos de stall no core de destino). Só se aplica com
+// a cache desligada: com ela, L1 e TLB por core já cobram os misses frios.
+#ifndef AFFINITY_ENABLED
+#define AFFINITY_ENABLED true      // false = posicionamento oblívio
+#endif
+#define MIGRATION_CACHE_PENALTY 4  // Cache fria no core de destino
+#define WARM_CORE_PENALTY 1        // Mesmo core, mas outro processo rodou nele
+
+// Custo de troca de contexto (ciclos de stall cobrados do core)
+#ifndef CONTEXT_SWITCH_COST_ENABLED
+#define CONTEXT_SWITCH_COST_ENABLED true
+#endif
+#ifndef LAZY_RESTORE_ENABLED
+#define LAZY_RESTORE_ENABLED true  // Pula o restore se o contexto ainda está no core
+#endif
+#define PIPELINE_DRAIN_PENALTY 4   // Instruções em voo descartadas (IF..MEM)
+#define REGISTERS_PER_CYCLE 8      // Registradores transferidos por ciclo
+
 // Estrutura de core com suporte a threads
 typedef struct core {
     unsigned short int* registers;  // Ponteiro para array de registradores
@@ -21,6 +38,10 @@ typedef struct core {
     pthread_mutex_t mutex;
     bool running;
     architecture_state* arch_state;  
+    int last_pid;          // Último processo que rodou (cache/TLB quentes)
+    int stall_cycles;      // Ciclos de penalidade antes da próxima instrução
+    unsigned int dirty_registers; // Bitmask dos registradores escritos desde o restore
+    unsigned int loaded_version;  // Versão do contexto de last_pid presente no core
 } core;
 
 // CPU com mutex global de recursos e RAM
@@ -44,6 +65,7 @@ typedef struct core_thread_args {
 
 // Funções de inicialização e cleanup - Atualizada para incluir RAM
 void init_cpu(cpu* cpu, ram* memory_ram);
+void charge_context_switch(core* current_core, int cycles);
 void cleanup_cpu_threads(cpu* cpu);
 
 // Thread principal dos cores
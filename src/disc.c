@@ -1,19 +1,77 @@
 #include "disc.h"
 
-void init_disc(disc* memory_disc) {
-    memory_disc->matriz = malloc(NUM_MEMORY * sizeof(unsigned short int*));
-    for (int i = 0; i < NUM_MEMORY; i++) {
-        memory_disc->matriz[i] = malloc(NUM_MEMORY * sizeof(unsigned short int));
-    }
+bool init_disc(disc* memory_disc, int slots, int slot_size) {
+    if (!memory_disc || slots <= 0 || slot_size <= 0) return false;
 
-    if (memory_disc->matriz == NULL) {
+    memset(memory_disc, 0, sizeof(disc));
+    memory_disc->swap = calloc((size_t)slots * slot_size, sizeof(char));
+    memory_disc->slot_used = calloc(slots, sizeof(bool));
+    if (!memory_disc->swap || !memory_disc->slot_used) {
         printf("memory allocation failed in disc\n");
-        exit(1);
+        free_disc(memory_disc);
+        return false;
     }
 
-    for (int i = 0; i < NUM_MEMORY; i++) {
-        for (int j = 0; j < NUM_MEMORY; j++) {
-            memory_disc->matriz[i][j] = 0;
+    memory_disc->slots = slots;
+    memory_disc->slot_size = slot_size;
+    memory_disc->free_slots = slots;
+    memory_disc->head = -1;
+    return true;
+}
+
+void free_disc(disc* memory_disc) {
+    if (!memory_disc) return;
+
+    free(memory_disc->swap);
+    free(memory_disc->slot_used);
+    memory_disc->swap = NULL;
+    memory_disc->slot_used = NULL;
+    memory_disc->slots = memory_disc->free_slots = 0;
+}
+
+// Primeiro slot livre, ou -1 com o swap cheio
+int disc_alloc_slot(disc* memory_disc) {
+    if (!memory_disc || memory_disc->free_slots == 0) return -1;
+
+    for (int slot = 0; slot < memory_disc->slots; slot++) {
+        if (!memory_disc->slot_used[slot]) {
+            memory_disc->slot_used[slot] = true;
+            memory_disc->free_slots--;
+            return slot;
         }
     }
-}
\ No newline at end of file
+    return -1;
+}
+
+void disc_free_slot(disc* memory_disc, int slot) {
+    if (!memory_disc || slot < 0 || slot >= memory_disc->slots) return;
+    if (!memory_disc->slot_used[slot]) return;
+
+    memory_disc->slot_used[slot] = false;
+    memory_disc->free_slots++;
+}
+
+// Ciclos de um acesso: transferência, mais seek se a cabeça precisa mover
+static int access_latency(disc* memory_disc, int slot) {
+    int latency = DISC_TRANSFER_LATENCY;
+    if (slot != memory_disc->head + 1) latency += DISC_SEEK_LATENCY;
+    memory_disc->head = slot;
+    memory_disc->busy_cycles += latency;
+    return latency;
+}
+
+int disc_read_slot(disc* memory_disc, int slot, char* data) {
+    if (!memory_disc || !memory_disc->swap || slot < 0 || slot >= memory_disc->slots) return 0;
+
+    memcpy(data, memory_disc->swap + (size_t)slot * memory_disc->slot_size, memory_disc->slot_size);
+    memory_disc->reads++;
+    return access_latency(memory_disc, slot);
+}
+
+int disc_write_slot(disc* memory_disc, int slot, const char* data) {
+    if (!memory_disc || !memory_disc->swap || slot < 0 || slot >= memory_disc->slots) return 0;
+
+    memcpy(memory_disc->swap + (size_t)slot * memory_disc->slot_size, data, memory_disc->slot_size);
+    memory_disc->writes++;
+    return access_latency(memory_disc, slot);
+}
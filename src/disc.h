@@ -5,10 +5,36 @@
 
 #include "libs.h"
 
+// Disco como área de troca (swap) da memória virtual: slots de uma página,
+// ocupados por páginas expulsas da RAM. Cada acesso custa a transferência;
+// slot fora de sequência com o anterior paga também o seek.
+#ifndef SWAP_SLOTS
+#define SWAP_SLOTS 256
+#endif
+#ifndef DISC_SEEK_LATENCY
+#define DISC_SEEK_LATENCY 60
+#endif
+#ifndef DISC_TRANSFER_LATENCY
+#define DISC_TRANSFER_LATENCY 20   // Por página
+#endif
+
 typedef struct disc {
-    unsigned short int **matriz;
+    char* swap;           // slots * slot_size bytes
+    bool* slot_used;
+    int slots;
+    int slot_size;
+    int free_slots;
+    int head;             // Último slot acessado (posição da cabeça)
+    int reads;
+    int writes;
+    long busy_cycles;
 } disc;
 
-void init_disc(disc* memory_disc);
+bool init_disc(disc* memory_disc, int slots, int slot_size);
+void free_disc(disc* memory_disc);
+int disc_alloc_slot(disc* memory_disc);
+void disc_free_slot(disc* memory_disc, int slot);
+int disc_read_slot(disc* memory_disc, int slot, char* data);
+int disc_write_slot(disc* memory_disc, int slot, const char* data);
 
-#endif
\ No newline at end of file
+#endif
@@ -2,6 +2,10 @@
 #include <string.h>
 #include <stdlib.h>
 #include <ctype.h>
+#include "cache.h"
+#include "cache_hierarchy.h"
+#include "coherence.h"
+#include "virtual_memory.h"
 
 unsigned short int get_register_index(const char* reg_name) {
     static const char* register_names[] = {
@@ -44,12 +48,13 @@ unsigned short int ula(unsigned short int operating_a, unsigned short int operat
 unsigned short int verify_address(ram* memory_ram, char* address, unsigned short int num_positions) {
     //printf("\n[Verify] Verificando endereço: %s (tamanho: %d)", address, num_positions);
     
-    if (!memory_ram || !address || address[0] != 'A') {
+    // Endereço como "A<num>" ou só o número (ex.: STORE A0 200)
+    if (!memory_ram || !address || (address[0] != 'A' && !isdigit((unsigned char)address[0]))) {
         printf("\n[Verify] Erro: Parâmetros inválidos ou formato incorreto");
         return 0;
     }
 
-    unsigned short int pos = atoi(&address[1]);
+    unsigned short int pos = atoi(address[0] == 'A' ? &address[1] : address);
     printf("\n[Verify] Posição calculada: %d", pos);
     
     if (pos + num_positions >= NUM_MEMORY) {
@@ -60,6 +65,79 @@ unsigned short int verify_address(ram* memory_ram, char* address, unsigned short
     return pos;
 }
 
+// Cópia entre o core e o espaço virtual do processo, página a página: cada
+// trecho é traduzido (TLB, page walk e falta de página no primeiro toque)
+// e passa pela L1 quando habilitada. Devolve os ciclos de cache ou -1 se
+// uma falta não pôde ser atendida; a tradução atrasa o core direto.
+static int access_virtual(cpu* cpu, ram* memory_ram, unsigned short int index_core,
+                          unsigned int address, char* data, int length, bool write) {
+    PCB* process = cpu->core[index_core].current_process;
+    unsigned int pc = process ? process->base_address + process->PC : 0;
+    int latency = 0;
+
+    while (length > 0) {
+        int chunk = PAGE_SIZE - PAGE_OFFSET(address);
+        if (chunk > length) chunk = length;
+
+        int translation_latency = 0;
+        int physical = translate_address(memory_ram, process, index_core, address,
+                                         write, &translation_latency);
+        cpu->core[index_core].stall_cycles += translation_latency;
+        if (physical < 0) return -1;
+
+        if (!cache_enabled) {
+            // Sem cache cada bloco tocado paga o acesso à memória
+            if (write) memcpy(memory_ram->vector + physical, data, chunk);
+            else memcpy(data, memory_ram->vector + physical, chunk);
+            latency += ((physical + chunk - 1) / BLOCK_SIZE - physical / BLOCK_SIZE + 1) *
+                       MEMORY_LATENCY;
+        } else if (write) {
+            latency += cache_store(index_core, pc, physical, data, chunk);
+        } else {
+            latency += cache_load(index_core, pc, physical, data, chunk);
+        }
+
+        address += chunk;
+        data += chunk;
+        length -= chunk;
+    }
+    return latency;
+}
+
+static void stall_on_cache(cpu* cpu, unsigned short int index_core, int latency) {
+    architecture_state* state = cpu->core[index_core].arch_state;
+    if (CACHE_STALLS_ENABLED && state && latency > 0) {
+        cpu->core[index_core].stall_cycles += latency;
+        state->memory_stall_cycles += latency;
+    }
+}
+
+// Valor decimal guardado por STORE no endereço virtual (até o terminador)
+static unsigned short int load_from_memory(cpu* cpu, ram* memory_ram, const char* operand,
+                                           unsigned short int index_core) {
+    char text[WORD_TEXT_LENGTH + 1] = {0};
+    unsigned int address = verify_address(memory_ram, (char*)operand, 1);
+    int length = WORD_TEXT_LENGTH;
+    if (address + length > NUM_MEMORY) length = NUM_MEMORY - address;
+
+    // Lê até o fim da página; só toca a seguinte se o número continuar nela
+    int first = PAGE_SIZE - PAGE_OFFSET(address);
+    if (first > length) first = length;
+    int latency = access_virtual(cpu, memory_ram, index_core, address, text, first, false);
+    if (latency >= 0 && first < length && !memchr(text, '\0', first)) {
+        int rest = access_virtual(cpu, memory_ram, index_core, address + first,
+                                  text + first, length - first, false);
+        latency = rest < 0 ? -1 : latency + rest;
+    }
+
+    if (latency < 0) {
+        printf("\n[Load] Falta de página em %u não atendida (sem frame livre)", address);
+        return 0;
+    }
+    stall_on_cache(cpu, index_core, latency);
+    return atoi(text);
+}
+
 void load(cpu* cpu, const char* instruction, unsigned short int index_core) {
     char *instruction_copy, *token, *register_name;
     unsigned short int value, register_index;
@@ -83,12 +161,18 @@ void load(cpu* cpu, const char* instruction, unsigned short int index_core) {
     token = strtok(NULL, " ");
     trim(token);
 
-    value = atoi(token);
+    // LOAD R <imediato> ou LOAD R A<n> (endereço virtual de dados)
+    if (token[0] == 'A') {
+        value = load_from_memory(cpu, cpu->memory_ram, token, index_core);
+    } else {
+        value = atoi(token);
+    }
 
     trim(register_name);
     register_index = get_register_index(register_name);
 
     cpu->core[index_core].registers[register_index] = value;
+    cpu->core[index_core].dirty_registers |= 1u << register_index;
 
     free(instruction_copy);
 }
@@ -136,13 +220,19 @@ void store(cpu* cpu, ram* memory_ram, const char* instruction, unsigned short in
     sprintf(buffer, "%d", register_value);  
    // printf("\n[Store] Valor convertido: %s", buffer);
 
-    // Verifica endereço
+    // Verifica endereço (virtual, traduzido pela tabela de páginas do processo)
     unsigned short int address = verify_address(memory_ram, memory_address, strlen(buffer));
     //printf("\n[Store] Endereço verificado: %d", address);
-    
-    // Escreve na RAM
-    write_ram(memory_ram, address, buffer);
-    //printf("\n[Store] Escrita na RAM concluída");
+
+    // Terminador incluso; com cache, a L1 decide quando a RAM recebe os
+    // dados (política de escrita)
+    int latency = access_virtual(cpu, memory_ram, index_core, address,
+                                 buffer, strlen(buffer) + 1, true);
+    if (latency < 0) {
+        printf("\n[Store] Falta de página em %d não atendida (sem frame livre)", address);
+    } else {
+        stall_on_cache(cpu, index_core, latency);
+    }
 
     free(instruction_copy);
     //printf("\n[Store] Instrução concluída\n");
@@ -719,6 +809,105 @@ type_of_instruction instruction_decode(const char* instruction) {
     return INVALID;
 }
 
+// Estimativa estática de instruções executadas: cada linha é multiplicada
+// pelas contagens dos laços que a envolvem. Registradores só mudam via
+// LOAD imediato, então LOOP <reg> é resolvido pelo último LOAD visto.
+int estimate_program_instructions(const char* program) {
+    if (!program) return 0;
+
+    int known_values[NUM_REGISTERS] = {0};
+    int multipliers[MAX_LOOP_DEPTH + 1];
+    int depth = 0;
+    int total = 0;
+    multipliers[0] = 1;
+
+    const char* line = program;
+    while (line && *line) {
+        const char* end = strchr(line, '\n');
+        size_t len = end ? (size_t)(end - line) : strlen(line);
+
+        char buffer[64];
+        if (len >= sizeof(buffer)) len = sizeof(buffer) - 1;
+        memcpy(buffer, line, len);
+        buffer[len] = '\0';
+
+        char* text = buffer;
+        while (*text && isspace((unsigned char)*text)) text++;
+
+        if (*text) {
+            char op[10] = {0}, arg1[10] = {0}, arg2[10] = {0};
+            sscanf(text, "%9s %9s %9s", op, arg1, arg2);
+            type_of_instruction type = decode_instruction(op);
+
+            if (type == LOAD && arg1[0] && isdigit((unsigned char)arg2[0])) {
+                known_values[get_register_index(arg1)] = atoi(arg2);
+            }
+
+            if (type == LOOP && depth < MAX_LOOP_DEPTH) {
+                int trips = isdigit((unsigned char)arg1[0]) ?
+                            atoi(arg1) : known_values[get_register_index(arg1)];
+                if (trips <= 0) trips = 1;
+                multipliers[depth + 1] = multipliers[depth] * trips;
+                depth++;
+            }
+
+            total += multipliers[depth];
+
+            if (type == L_END && depth > 0) {
+                depth--;
+            }
+        }
+
+        line = end ? end + 1 : NULL;
+    }
+    return total;
+}
+
+// Histograma de tipos + tipo/hash das primeiras linhas, para que a
+// similaridade entre programas seja calculada sem reprocessar texto.
+void compute_instruction_signature(const char* program, instruction_signature* signature) {
+    if (!signature) return;
+    memset(signature, 0, sizeof(instruction_signature));
+    if (!program) return;
+
+    const char* line = program;
+    int line_index = 0;
+    while (line && *line) {
+        const char* end = strchr(line, '\n');
+        size_t len = end ? (size_t)(end - line) : strlen(line);
+
+        while (len > 0 && isspace((unsigned char)*line)) {
+            line++;
+            len--;
+        }
+        while (len > 0 && isspace((unsigned char)line[len - 1])) len--;
+
+        // FNV-1a da linha normalizada
+        unsigned int hash = 2166136261u;
+        for (size_t i = 0; i < len; i++) {
+            hash = (hash ^ (unsigned char)line[i]) * 16777619u;
+        }
+
+        char op[10] = {0};
+        size_t op_len = 0;
+        while (op_len < len && op_len < sizeof(op) - 1 && !isspace((unsigned char)line[op_len])) {
+            op[op_len] = line[op_len];
+            op_len++;
+        }
+        type_of_instruction type = len > 0 ? decode_instruction(op) : INVALID;
+
+        if (len > 0) signature->type_histogram[type]++;
+        if (line_index < SIGNATURE_PREFIX) {
+            signature->prefix_types[line_index] = type;
+            signature->prefix_hashes[line_index] = hash;
+            signature->prefix_length = line_index + 1;
+        }
+
+        line_index++;
+        line = end ? end + 1 : NULL;
+    }
+}
+
 // Em instruction_utils.c
 void execute_instruction(cpu* cpu, ram* memory_ram, const char* instruction,
                        type_of_instruction type, int core_id,
@@ -6,6 +6,9 @@
 #include "ram.h"
 #include "reader.h"
 
+#define MAX_LOOP_DEPTH 16  // Aninhamento máximo considerado na estimativa
+#define WORD_TEXT_LENGTH 6 // Valor de registrador em texto ("65535" + terminador)
+
 // Funções de operações básicas
 unsigned short int get_register_index(const char* reg_name);
 unsigned short int ula(unsigned short int operating_a, unsigned short int operating_b, type_of_instruction operation);
@@ -32,6 +35,8 @@ void trim(char* str);
 void normalize_indentation(char* str);         
 char* instruction_fetch(cpu* cpu, char* program, unsigned short int index_core);
 type_of_instruction instruction_decode(const char* instruction);
+int estimate_program_instructions(const char* program);
+void compute_instruction_signature(const char* program, instruction_signature* signature);
 void execute_instruction(cpu* cpu, ram* memory_ram, const char* instruction,
                        type_of_instruction type, int core_id,
                        instruction_processor* instr_processor, const char* program);
@@ -6,9 +6,14 @@
 #include "ram.h"
 #include "policies/policy.h"
 #include "policies/policy_selector.h"
+#include "workload.h"
+#include "cache_replacement.h"
+#include "cache_events.h"
+#include "virtual_memory.h"
 #include <time.h>
 #include <sys/time.h>
-// #include "tlb.h"
+#include "tlb.h"
+#include "write_buffer.h"
 
 
 void clean_ready_queue(ProcessManager* pm) {
@@ -35,10 +40,10 @@ void init_system(void) {
 int main(void) {
 
     init_system();
-    init_process_tlb();
+    reset_tlb();
 
     // Inicialização dos componentes
-    cpu* cpu = malloc(sizeof(cpu));
+    cpu* cpu = malloc(sizeof(*cpu));
     ram* memory_ram = allocate_ram(NUM_MEMORY);
 
     if (!memory_ram || !memory_ram->vector) {
@@ -65,6 +70,7 @@ int main(void) {
     arch_state->process_manager = pm;
 
     init_cache();
+    reset_virtual_memory();
 
         printf("\n╔════════ Configuração de Cache ═══════════════════════════════════════════  ╗");
         printf("\n║  Deseja utilizar cache? (s/n):  Para o MMU  -   sem utilizar a cache       ║");
@@ -76,6 +82,8 @@ int main(void) {
 
         if (cache_enabled) {
             printf("\n[Cache] Cache habilitada - Executando com otimizações");
+            select_replacement_policy();
+            if (CACHE_EVENT_TRACE) set_cache_event_sink(print_cache_event);
         } else {
             printf("\n[Cache] Cache desabilitada - Executando sem otimizações");
         }
@@ -100,33 +108,14 @@ int main(void) {
 
     cpu->process_manager->policy = selected_policy;
 
-    // Carregamento dos programas
-    printf("\n[Sistema] Carregando programas\n");
-    char* program_files[] = {"program.txt", "program2.txt", "program3.txt"};
-    int num_programs = sizeof(program_files) / sizeof(program_files[0]);
-    unsigned int base_address;
-    char* program;
-    for (int i = 0; i < num_programs; i++) {
-
-        char filename[100];
-        snprintf(filename, sizeof(filename), "dataset/%s", program_files[i]);
-
-        PCB* process = create_pcb();
-        program = read_program(filename);
-        if (process && program) {
-            base_address = i * (NUM_MEMORY / MAX_PROCESSES);
-            process->base_address = base_address;
-            process->memory_limit = base_address + (NUM_MEMORY / MAX_PROCESSES) - 1;
-            
-            load_program_on_ram(cpu, program, base_address, process);
-            process->state = READY;
-            cpu->process_manager->ready_queue[cpu->process_manager->ready_count++] = process;
-            
-            show_process_state(process->pid, "CREATED", "READY");
-            free(program);
-        }
-        print_tlb_contents();
+    // Trace de carga: cada programa entra no seu ciclo de chegada
+    printf("\n[Sistema] Carregando trace de carga\n");
+    workload wl;
+    if (!load_workload(&wl, WORKLOAD_FILE)) {
+        printf("[Workload] %s indisponível, usando os programas padrão no ciclo 0\n", WORKLOAD_FILE);
+        default_workload(&wl);
     }
+    admit_arrivals(cpu, &wl, 0);
 
     show_scheduler_state(cpu->process_manager->ready_count, 0);
 
@@ -151,17 +140,22 @@ int main(void) {
     cpu->process_manager->current_time = cycle_count;
     show_cycle_start(cycle_count);
 
+    // Chegadas deste ciclo entram na fila sem interromper a execução
+    admit_arrivals(cpu, &wl, cycle_count);
 
-    // Escalonar processos para cores disponíveis
-for (int core_id = 0; core_id < NUM_CORES; core_id++) {
-    if (cpu->core[core_id].is_available && 
-        cpu->process_manager->ready_count > 0) {
-        
-        // Garantir que o quantum seja resetado
-        cpu->core[core_id].quantum_remaining = cpu->process_manager->quantum_size;
-        schedule_next_process(cpu, core_id);
+
+    // Preempção por política (ex.: SRTF) antes de preencher os cores livres
+    for (int core_id = 0; core_id < NUM_CORES; core_id++) {
+        if (!cpu->core[core_id].is_available) {
+            check_preemption(cpu, core_id);
+        } else if (cpu->core[core_id].stall_cycles > 0) {
+            // Core ocioso termina de drenar/salvar o contexto anterior
+            cpu->core[core_id].stall_cycles--;
+        }
     }
-}
+
+    // Escalonar processos para cores disponíveis
+    schedule_ready_processes(cpu);
     // Executar processos nos cores
     int running_count = 0;
     for (int core_id = 0; core_id < NUM_CORES; core_id++) {
@@ -177,10 +171,7 @@ for (int core_id = 0; core_id < NUM_CORES; core_id++) {
                 PCB* current_process = cpu->core[core_id].current_process;
                 
                 // Usar a política para tratar o quantum expirado
-                cpu->process_manager->policy->on_quantum_expired(
-                    cpu->process_manager, 
-                    current_process
-                );
+                requeue_expired_process(cpu->process_manager, current_process);
                 
                 // Liberar o core
                 release_core(cpu, core_id);
@@ -188,8 +179,17 @@ for (int core_id = 0; core_id < NUM_CORES; core_id++) {
         }
     }
 
+    if (cache_enabled) write_buffer_tick();
+
+    // Ajuste do quantum ao fim de cada janela de observação
+    cpu->process_manager->tuner.busy_cycles += running_count;
+    if (cycle_count % QUANTUM_TUNE_INTERVAL == 0) {
+        tune_quantum(cpu->process_manager);
+    }
+
     // Verificar término
-    if (cpu->process_manager->ready_count == 0 && running_count == 0) {
+    if (cpu->process_manager->ready_count == 0 && running_count == 0 &&
+        !workload_pending(&wl)) {
         bool all_done = true;
         for (int i = 0; i < total_processes; i++) {
             if (all_processes[i] && all_processes[i]->state != FINISHED) {
@@ -206,20 +206,24 @@ for (int core_id = 0; core_id < NUM_CORES; core_id++) {
 
 
 
-    usleep(50000);
+    usleep(CYCLE_DELAY_US);
 }
 
         if (cache_enabled) {
+            cache_flush_dirty_lines();
             printf("\n\n═══════════ Métricas de Cache ═══════════");
             printf("\nSpeedup com cache: %.2fx", get_speedup_ratio());
             printf("\nModo de execução: Otimizado");
             printf("\n═════════════════════════════════════\n");
             print_cache_statistics();
+            print_replacement_comparison();
         } else {
             printf("\n\n═══════════ Métricas de Cache ═══════════");
             printf("\nModo de execução: Sem otimizações");
             printf("\n═════════════════════════════════════\n");
         }
+        print_virtual_memory_statistics();
+        print_tlb_statistics();
 
     printf("\n[Sistema] Limpando recursos...");
     
@@ -233,7 +237,9 @@ for (int core_id = 0; core_id < NUM_CORES; core_id++) {
 
     // Limpeza final
     // printf("[Sistema] Liberando recursos\n");
-    free_process_tlb();
+    free_workload(&wl);
+    free_replacement_trace();
+    free_cache();
     free_architecture(cpu, memory_ram, memory_disc, p, arch_state, cycle_count);
     clock_t end = clock();
     double cpu_time_used = ((double) (end - start)) / CLOCKS_PER_SEC;
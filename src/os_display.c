@@ -19,7 +19,7 @@ void show_pipeline_status(int cycle, int core_id, PCB* process) {
     printf("\n - Processo: %d", process->pid);
     printf("\n - PC: %d", process->PC);
     printf("\n - Estado: %s", state_to_string(process->state));
-    printf("\n - Instruções executadas: %d", process->total_instructions);
+    printf("\n - Instruções executadas: %d", process->cold->total_instructions);
     printf("\n - Quantum restante: %d\n", process->quantum_remaining);
 }
 
@@ -30,9 +30,14 @@ void show_policy_menu(void) {
     printf("\n%s║%s  [2] %-35s%s║%s", COLOR_BLUE, COLOR_YELLOW, "Shortest Job First (SJF)", COLOR_BLUE, COLOR_RESET);
     printf("\n%s║%s  [3] %-35s%s║%s", COLOR_BLUE, COLOR_YELLOW, "Lottery Scheduling", COLOR_BLUE, COLOR_RESET);
     printf("\n%s║%s  [4] %-35s%s║%s", COLOR_BLUE, COLOR_YELLOW, "Cache-Aware Scheduling", COLOR_BLUE, COLOR_RESET);
+    printf("\n%s║%s  [5] %-35s%s║%s", COLOR_BLUE, COLOR_YELLOW, "Shortest Remaining Time (SRTF)", COLOR_BLUE, COLOR_RESET);
+    printf("\n%s║%s  [6] %-35s%s║%s", COLOR_BLUE, COLOR_YELLOW, "Multi-Level Feedback Queue", COLOR_BLUE, COLOR_RESET);
+    printf("\n%s║%s  [7] %-35s%s║%s", COLOR_BLUE, COLOR_YELLOW, "Completely Fair Scheduler (CFS)", COLOR_BLUE, COLOR_RESET);
+    printf("\n%s║%s  [8] %-35s%s║%s", COLOR_BLUE, COLOR_YELLOW, "Cache-Aware Gang Scheduling", COLOR_BLUE, COLOR_RESET);
+    printf("\n%s║%s  [9] %-35s%s║%s", COLOR_BLUE, COLOR_YELLOW, "Earliest Deadline First (EDF)", COLOR_BLUE, COLOR_RESET);
     printf("\n%s║                                           ║%s", COLOR_BLUE, COLOR_RESET);
     printf("\n%s╚═══════════════════════════════════════════╝%s", COLOR_BLUE, COLOR_RESET);
-    printf("\n%sEscolha uma opção (1-4):%s ", COLOR_CYAN, COLOR_RESET);
+    printf("\n%sEscolha uma opção (1-9):%s ", COLOR_CYAN, COLOR_RESET);
 }
 
 void show_policy_selected(const char* policy_name) {
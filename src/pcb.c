@@ -2,32 +2,101 @@
 #include "cpu.h"
 #include "os_display.h"
 #include "cache.h"
+#include "cache_events.h"
+#include "virtual_memory.h"
 
-extern CacheEntry cache[CACHE_SIZE];
-
-PCB* all_processes[MAX_PROCESSES];
+PCB** all_processes = NULL;
+process_record* process_records = NULL;
 int total_processes = 0;
+static int process_capacity = 0;
+
+// Free list e tabela: criação na thread principal, reciclagem nos cores
+static pthread_mutex_t pcb_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+// Slab de PCBs: blocos de PCB_POOL_CHUNK estruturas que nunca mudam de
+// endereço (filas e árvores guardam ponteiros); PCBs liberados voltam
+// para a free list e são reaproveitados antes de um novo bloco.
+// Cada bloco separa em vetores próprios a parte quente (PCB), a parte
+// fria e os registradores, para que varreduras do escalonador percorram
+// só PCBs contíguos e compactos.
+typedef struct pcb_chunk {
+    struct pcb_chunk* next;
+    PCB slots[PCB_POOL_CHUNK];
+    pcb_cold cold[PCB_POOL_CHUNK];
+    unsigned short int registers[PCB_POOL_CHUNK][NUM_REGISTERS];
+} pcb_chunk;
+
+static pcb_chunk* pcb_chunks = NULL;
+static PCB* pcb_free_list = NULL;
+
+static PCB* pcb_pool_alloc(void) {
+    if (!pcb_free_list) {
+        pcb_chunk* chunk = malloc(sizeof(pcb_chunk));
+        if (!chunk) return NULL;
+
+        chunk->next = pcb_chunks;
+        pcb_chunks = chunk;
+        for (int i = PCB_POOL_CHUNK - 1; i >= 0; i--) {
+            chunk->slots[i].cold = &chunk->cold[i];
+            chunk->slots[i].registers = chunk->registers[i];
+            chunk->slots[i].next_free = pcb_free_list;
+            pcb_free_list = &chunk->slots[i];
+        }
+    }
+
+    PCB* pcb = pcb_free_list;
+    pcb_free_list = pcb->next_free;
+    return pcb;
+}
+
+// Tabela de processos e de registros indexadas por PID, dobradas quando enchem
+static bool reserve_process_table(int needed) {
+    if (needed <= process_capacity) return true;
+
+    int capacity = process_capacity ? process_capacity : INITIAL_PROCESS_CAPACITY;
+    while (capacity < needed) capacity *= 2;
+
+    PCB** table = realloc(all_processes, capacity * sizeof(PCB*));
+    if (!table) return false;
+    all_processes = table;
+
+    process_record* records = realloc(process_records, capacity * sizeof(process_record));
+    if (!records) return false;
+    memset(records + process_capacity, 0,
+           (capacity - process_capacity) * sizeof(process_record));
+    process_records = records;
+
+    process_capacity = capacity;
+    return true;
+}
 
 PCB* create_pcb(void) {
-    if (total_processes >= MAX_PROCESSES) {
-        printf("[Sistema] Erro: Limite de processos atingido (%d)\n", MAX_PROCESSES);
+    pthread_mutex_lock(&pcb_pool_mutex);
+    if (!reserve_process_table(total_processes + 1)) {
+        pthread_mutex_unlock(&pcb_pool_mutex);
+        printf("[Sistema] Erro: Falha ao expandir a tabela de processos\n");
         return NULL;
     }
 
-    PCB* pcb = malloc(sizeof(PCB));
+    PCB* pcb = pcb_pool_alloc();
     if (!pcb) {
+        pthread_mutex_unlock(&pcb_pool_mutex);
         printf("[Sistema] Erro: Falha na alocação de processo\n");
         return NULL;
     }
 
-    pcb->pid = total_processes;
-    insert_pid_in_tlb(pcb->pid);
-
-    char* binary_pid = lookup_pid_in_tlb(pcb->pid);
-    if (binary_pid) {
-        printf("[Sistema] Processo %d criado (PID Binário: %s)\n", pcb->pid, binary_pid);
+    // Espaço de endereçamento vazio: páginas mapeadas no primeiro acesso
+    pcb->page_table = NULL;
+    if (!create_address_space(pcb)) {
+        pcb->next_free = pcb_free_list;
+        pcb_free_list = pcb;
+        pthread_mutex_unlock(&pcb_pool_mutex);
+        printf("[Sistema] Erro: Falha na alocação da tabela de páginas\n");
+        return NULL;
     }
 
+    pcb->pid = total_processes;
+
     pcb->state = NEW;
     pcb->core_id = -1;
     pcb->PC = 0;
@@ -36,31 +105,34 @@ PCB* create_pcb(void) {
     pcb->base_address = 0;
     pcb->memory_limit = NUM_MEMORY;
     pcb->was_completed = false;
-    pcb->start_time = 0;  
-    pcb->lottery_selections = 0;
-    pcb->waiting_time = 0;
-    pcb->response_time = -1; // -1 indica que ainda não começou execução
-    pcb->turnaround_time = 0;
     pcb->last_scheduled = 0;
-
-    pcb->registers = calloc(NUM_REGISTERS, sizeof(unsigned short int));
-    if (!pcb->registers) {
-        printf("[Sistema] Erro: Falha na alocação dos registradores\n");
-        free(pcb);
-        return NULL;
-    }
-
-    pcb->using_io = false;
+    pcb->ready_since = 0;
     pcb->io_block_cycles = 0;
-    pcb->waiting_resource = false;
-    pcb->resource_name = NULL;
-
-    pcb->total_instructions = 0;
-    pcb->waiting_time = 0;
-    pcb->turnaround_time = 0;
-    pcb->completion_time = 0;
+    pcb->estimated_instructions = 0;
+    pcb->burst_estimate = DEFAULT_QUANTUM;
+    pcb->current_burst = 0;
+    pcb->priority_level = 0;
+    pcb->vruntime = 0;
+    memset(&pcb->run_node, 0, sizeof(cfs_node));
+    pcb->run_node.owner = pcb;
+    pcb->tickets = LOTTERY_DEFAULT_TICKETS;
+    pcb->compensation_tickets = 0;
+    pcb->gang_dispatched = false;
+    pcb->preempted = false;
+    pcb->similarity_group = -1;
+    pcb->absolute_deadline = -1;
+    pcb->admitted = false;
+    pcb->context_version = 0;
+    pcb->next_free = NULL;
+    memset(pcb->registers, 0, NUM_REGISTERS * sizeof(unsigned short int));
+
+    // Parte fria: zerada, exceto os sentinelas
+    memset(pcb->cold, 0, sizeof(pcb_cold));
+    pcb->cold->response_time = -1; // -1 indica que ainda não começou execução
+    pcb->cold->priority = 1;
 
     all_processes[total_processes++] = pcb;
+    pthread_mutex_unlock(&pcb_pool_mutex);
     printf("[Sistema] Processo %d criado\n", pcb->pid);
     show_process_state(pcb->pid, "CREATED", "NEW");
 
@@ -70,38 +142,125 @@ PCB* create_pcb(void) {
 void save_context(PCB* pcb, core* current_core) {
     if (!pcb || !current_core) return;
 
-    // Salva PC e outros estados
+    // Salva PC e apenas os registradores escritos desde o último restore
     pcb->PC = current_core->PC;
-    memcpy(pcb->registers, current_core->registers, NUM_REGISTERS * sizeof(unsigned short int));
+    unsigned int dirty = current_core->dirty_registers;
+    while (dirty) {
+        int reg = __builtin_ctz(dirty);
+        pcb->registers[reg] = current_core->registers[reg];
+        dirty &= dirty - 1;
+    }
+    current_core->dirty_registers = 0;
     pcb->quantum_remaining = current_core->quantum_remaining;
+
+    // O core passa a guardar uma cópia idêntica desta versão do contexto
+    pcb->context_version++;
+    current_core->loaded_version = pcb->context_version;
     
    // printf("\n[Context] Salvando contexto do processo %d", pcb->pid);
    // printf("\n - PC: %d", pcb->PC);
    // printf("\n - Quantum: %d", pcb->quantum_remaining);
 }
 
-void restore_context(PCB* pcb, core* current_core) {
-    if (!pcb || !current_core) return;
+// Retorna true quando os registradores precisaram ser copiados; se o
+// processo volta ao core onde salvou a versão atual do contexto, a cópia
+// é dispensada (restore preguiçoso).
+bool restore_context(PCB* pcb, core* current_core) {
+    if (!pcb || !current_core) return false;
 
+    bool copied = true;
     current_core->PC = pcb->PC;
-    memcpy(current_core->registers, pcb->registers, NUM_REGISTERS * sizeof(unsigned short int));
+    if (LAZY_RESTORE_ENABLED && current_core->last_pid == pcb->pid &&
+        current_core->loaded_version == pcb->context_version) {
+        copied = false;
+    } else {
+        memcpy(current_core->registers, pcb->registers, NUM_REGISTERS * sizeof(unsigned short int));
+    }
+    current_core->dirty_registers = 0;
     current_core->quantum_remaining = pcb->quantum_remaining;
     
     // printf("\n[Context] Restaurando contexto do processo %d", pcb->pid);
     // printf("\n - PC: %d", current_core->PC);
     //printf("\n - Quantum: %d", current_core->quantum_remaining);
+    return copied;
 }
 
 void free_pcb(PCB* pcb) {
     if (!pcb) return;
 
-    if (pcb->registers) {
-        free(pcb->registers);
+    // Registradores e parte fria pertencem ao slab
+    if (pcb->cold->resource_name) {
+        free(pcb->cold->resource_name);
     }
-    if (pcb->resource_name) {
-        free(pcb->resource_name);
+    pcb->cold->resource_name = NULL;
+
+    // Frames já voltaram com a RAM; só a tabela é do PCB
+    free(pcb->page_table);
+    pcb->page_table = NULL;
+
+    // Volta para o pool
+    pthread_mutex_lock(&pcb_pool_mutex);
+    pcb->next_free = pcb_free_list;
+    pcb_free_list = pcb;
+    pthread_mutex_unlock(&pcb_pool_mutex);
+}
+
+// Copia para a tabela de registros o que o relatório final usa
+void record_process(PCB* pcb) {
+    if (!pcb) return;
+
+    process_record* record = &process_records[pcb->pid];
+    record->recorded = true;
+    record->was_completed = pcb->was_completed;
+    record->admitted = pcb->admitted;
+    record->deadline_missed = pcb->cold->deadline_missed;
+    record->pid = pcb->pid;
+    record->priority_level = pcb->priority_level;
+    record->tickets = pcb->tickets;
+    record->absolute_deadline = pcb->absolute_deadline;
+    record->estimated_instructions = pcb->estimated_instructions;
+    record->cycles_executed = pcb->cycles_executed;
+    record->burst_estimate = pcb->burst_estimate;
+    record->vruntime = pcb->vruntime;
+    record->program_size = pcb->cold->program_size;
+    record->total_instructions = pcb->cold->total_instructions;
+    record->lottery_selections = pcb->cold->lottery_selections;
+    record->arrival_time = pcb->cold->arrival_time;
+    record->completion_time = pcb->cold->completion_time;
+    record->response_time = pcb->cold->response_time;
+    record->waiting_time = pcb->cold->waiting_time;
+    record->turnaround_time = pcb->cold->turnaround_time;
+    record->cache_hits = pcb->cold->cache_hits;
+    record->cache_misses = pcb->cold->cache_misses;
+}
+
+// Processo finalizado: métricas ficam no registro e o PCB volta ao pool.
+// O chamador já devolveu a região do programa e o espaço de endereçamento.
+void retire_pcb(PCB* pcb) {
+    if (!pcb) return;
+
+    // Sob o mutex do pool: a criação pode estar realocando as tabelas
+    pthread_mutex_lock(&pcb_pool_mutex);
+    record_process(pcb);
+    all_processes[pcb->pid] = NULL;
+    pthread_mutex_unlock(&pcb_pool_mutex);
+    free_pcb(pcb);
+}
+
+void destroy_pcb_pool(void) {
+    while (pcb_chunks) {
+        pcb_chunk* next = pcb_chunks->next;
+        free(pcb_chunks);
+        pcb_chunks = next;
     }
-    free(pcb);
+    pcb_free_list = NULL;
+
+    free(all_processes);
+    all_processes = NULL;
+    free(process_records);
+    process_records = NULL;
+    process_capacity = 0;
+    total_processes = 0;
 }
 
 const char* state_to_string(process_state state) {
@@ -125,8 +284,9 @@ ProcessManager* init_process_manager(int quantum_size) {
     // printf("\n[Debug] Inicializando Process Manager");
     // printf("\n - Endereço: %p", (void*)pm);
     
-    pm->ready_queue = malloc(sizeof(PCB*) * MAX_PROCESSES);
-    pm->blocked_queue = malloc(sizeof(PCB*) * MAX_PROCESSES);
+    pm->queue_capacity = INITIAL_PROCESS_CAPACITY;
+    pm->ready_queue = malloc(sizeof(PCB*) * pm->queue_capacity);
+    pm->blocked_queue = malloc(sizeof(PCB*) * pm->queue_capacity);
 
     if (!pm->ready_queue || !pm->blocked_queue) {
         printf("[Sistema] Erro: Falha na alocação das filas\n");
@@ -139,6 +299,12 @@ ProcessManager* init_process_manager(int quantum_size) {
     pm->quantum_size = quantum_size;
     pm->current_time = 0;
     pm->policy = NULL;  
+    sim_rng_seed(&pm->rng, DEFAULT_SEED);
+    pm->admitted_utilization = 0.0f;
+    pm->admitted_max_utilization = 0.0f;
+    pm->admitted_count = 0;
+    pm->rejected_processes = 0;
+    memset(&pm->tuner, 0, sizeof(quantum_tuner));
 
     pthread_mutex_init(&pm->queue_mutex, NULL);
     pthread_mutex_init(&pm->resource_mutex, NULL);
@@ -148,6 +314,45 @@ ProcessManager* init_process_manager(int quantum_size) {
     return pm;
 }
 
+// Escolhe o core do processo selecionado: o último core, se livre e com
+// afinidade habilitada; senão o core livre que pediu o escalonamento.
+// Cobra em stall_cycles o custo de cache/TLB frios no core de destino.
+static int place_process(cpu* cpu, PCB* process, int free_core) {
+    int target = free_core;
+    int last_core = process->core_id;
+
+    if (AFFINITY_ENABLED && last_core >= 0 && last_core < NUM_CORES &&
+        cpu->core[last_core].is_available) {
+        target = last_core;
+    }
+
+    core* target_core = &cpu->core[target];
+    architecture_state* state = target_core->arch_state;
+    int penalty = 0;
+
+    if (last_core < 0) {
+        // Primeiro despacho: custo compulsório, igual nos dois modos
+    } else if (last_core == target) {
+        if (target_core->last_pid != process->pid && !cache_enabled) {
+            penalty = WARM_CORE_PENALTY;
+        }
+        if (state) state->affinity_hits++;
+    } else {
+        // A TLB por core é sempre modelada; a cache fria só é estimada
+        // quando a L1 não existe para cobrar os misses de verdade
+        if (!cache_enabled) penalty = MIGRATION_CACHE_PENALTY;
+        process->cold->migrations++;
+        if (state) state->migrations++;
+        printf("\n[Afinidade] P%d migrou do core %d para o core %d",
+               process->pid, last_core, target);
+    }
+
+    target_core->stall_cycles += penalty;
+    if (state) state->affinity_stall_cycles += penalty;
+
+    return target;
+}
+
 void schedule_next_process(cpu* cpu, int core_id) {
   if (!cpu || !cpu->process_manager) return;
 
@@ -155,32 +360,39 @@ void schedule_next_process(cpu* cpu, int core_id) {
   lock_process_manager(pm);
 
   if (pm->ready_count > 0) {
-      // Métricas específicas para Cache-Aware
-      if (pm->policy->type == POLICY_CACHE_AWARE) {
+      // Métricas específicas para Cache-Aware (uma caixa por processo pronto,
+      // só no trace)
+      if (pm->policy->type == POLICY_CACHE_AWARE && CACHE_EVENT_TRACE) {
           printf("\n[Cache Analysis] Escalonando processos");
         //   printf("\n[Debug] Core %d scheduling (Ready: %d)", core_id, pm->ready_count);
           printf("\n - Core %d available: %d", core_id, cpu->core[core_id].is_available);
           
           for(int i = 0; i < pm->ready_count; i++) {
               PCB* process = pm->ready_queue[i];
-              CacheEntry* entry = &cache[process->base_address % CACHE_SIZE];
+              int hits = process->cold->cache_hits;
+              int misses = process->cold->cache_misses;
               
               printf("\n\nProcesso P%d:", process->pid);
-              printf("\n - Hits/Misses: %d/%d", entry->hits, entry->misses);
-              printf("\n - Hit Ratio: %.2f%%", entry->hit_ratio * 100);
-              printf("\n - Último acesso: %lds atrás", time(NULL) - entry->last_access);
+              printf("\n - Hits/Misses: %d/%d", hits, misses);
+              printf("\n - Hit Ratio: %.2f%%", hits + misses > 0 ? (float)hits * 100 / (hits + misses) : 0.0f);
+              printf("\n - Blocos na cache: %.0f%%",
+                     cache_region_resident_fraction(process->pid) * 100);
           }
         //   printf("\n[Debug] About to call select_next");
       }
 
       PCB* next_process = pm->policy->select_next(pm);
       if (next_process) {
-          if (next_process->start_time == 0) {
-              next_process->start_time = pm->current_time;
+          core_id = place_process(cpu, next_process, core_id);
+
+          if (next_process->cold->start_time == 0) {
+              next_process->cold->start_time = pm->current_time;
           }
 
-            if (next_process->response_time == -1) {
-        next_process->response_time = pm->current_time;
+            if (next_process->cold->response_time == -1) {
+        next_process->cold->response_time = pm->current_time - next_process->cold->arrival_time;
+        pm->tuner.response_sum += next_process->cold->response_time;
+        pm->tuner.responses++;
     }
           
           cpu->core[core_id].quantum_remaining = pm->quantum_size;
@@ -191,10 +403,23 @@ void schedule_next_process(cpu* cpu, int core_id) {
           next_process->state = RUNNING;
           next_process->core_id = core_id;
 
-          next_process->waiting_time += (pm->current_time - next_process->last_scheduled);
+          // Só conta o tempo na fila: execução, stalls e bloqueios ficam de fora
+          next_process->cold->waiting_time += (pm->current_time - next_process->ready_since);
           next_process->last_scheduled = pm->current_time;
+          next_process->current_burst = 0;
           
-          restore_context(next_process, &cpu->core[core_id]);
+          core* target_core = &cpu->core[core_id];
+          if (restore_context(next_process, target_core)) {
+              int restore = (NUM_REGISTERS + REGISTERS_PER_CYCLE - 1) / REGISTERS_PER_CYCLE;
+              charge_context_switch(target_core, restore);
+              // Primeiro despacho e retorno de E/S não são trocas forçadas
+              if (next_process->preempted && CONTEXT_SWITCH_COST_ENABLED) {
+                  pm->tuner.switch_cycles += restore;
+              }
+          } else if (target_core->arch_state) {
+              target_core->arch_state->lazy_restores++;
+          }
+          next_process->preempted = false;
           show_process_state(next_process->pid, "READY", "RUNNING");
           
           if (pm->policy->type == POLICY_CACHE_AWARE) {
@@ -209,6 +434,27 @@ void schedule_next_process(cpu* cpu, int core_id) {
   unlock_process_manager(pm);
 }
 
+// Preenche os cores livres; o core de destino pode diferir do core livre
+// encontrado (afinidade), por isso a busca é refeita a cada despacho.
+void schedule_ready_processes(cpu* cpu) {
+    if (!cpu || !cpu->process_manager) return;
+
+    for (int attempt = 0; attempt < NUM_CORES; attempt++) {
+        if (cpu->process_manager->ready_count == 0) break;
+
+        int free_core = -1;
+        for (int i = 0; i < NUM_CORES; i++) {
+            if (cpu->core[i].is_available) {
+                free_core = i;
+                break;
+            }
+        }
+        if (free_core == -1) break;
+
+        schedule_next_process(cpu, free_core);
+    }
+}
+
 void check_blocked_processes(cpu* cpu) {
     ProcessManager* pm = cpu->process_manager;
     
@@ -222,7 +468,7 @@ void check_blocked_processes(cpu* cpu) {
             process->io_block_cycles--;
             if (process->io_block_cycles == 0) {
                 process->state = READY;
-                pm->ready_queue[pm->ready_count++] = process;
+                enqueue_ready_process(pm, process);
                 
                 for (int j = i; j < pm->blocked_count - 1; j++) {
                     pm->blocked_queue[j] = pm->blocked_queue[j + 1];
@@ -238,6 +484,136 @@ void check_blocked_processes(cpu* cpu) {
     unlock_process_manager(pm);
 }
 
+// As filas comportam todos os processos já criados; como todo processo
+// entra por enqueue_ready_process, as políticas podem reinserir sem checar.
+static bool reserve_queues(ProcessManager* pm, int needed) {
+    if (needed <= pm->queue_capacity) return true;
+
+    int capacity = pm->queue_capacity;
+    while (capacity < needed) capacity *= 2;
+
+    PCB** ready = realloc(pm->ready_queue, capacity * sizeof(PCB*));
+    if (!ready) return false;
+    pm->ready_queue = ready;
+
+    PCB** blocked = realloc(pm->blocked_queue, capacity * sizeof(PCB*));
+    if (!blocked) return false;
+    pm->blocked_queue = blocked;
+
+    pm->queue_capacity = capacity;
+    return true;
+}
+
+void enqueue_ready_process(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    if (!reserve_queues(pm, total_processes)) {
+        printf("[Sistema] Erro: Falha ao expandir as filas de processos\n");
+        return;
+    }
+
+    process->ready_since = pm->current_time;
+
+    // Políticas com estrutura própria (ex.: heap do SJF) ordenam a inserção
+    if (pm->policy && pm->policy->on_process_ready) {
+        pm->policy->on_process_ready(pm, process);
+        return;
+    }
+
+    pm->ready_queue[pm->ready_count++] = process;
+}
+
+// Devolve à fila quem perdeu o core (quantum expirado ou preempção); a
+// política reinsere pela própria estrutura, sem passar por enqueue_ready_process
+void requeue_expired_process(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    process->ready_since = pm->current_time;
+    process->preempted = true;
+    pm->policy->on_quantum_expired(pm, process);
+}
+
+void check_preemption(cpu* cpu, int core_id) {
+    if (!cpu || !cpu->process_manager) return;
+
+    ProcessManager* pm = cpu->process_manager;
+    if (!pm->policy || !pm->policy->should_preempt) return;
+
+    lock_process_manager(pm);
+
+    core* current_core = &cpu->core[core_id];
+    PCB* running = current_core->current_process;
+
+    if (pm->ready_count > 0 && running && running->state == RUNNING &&
+        pm->policy->should_preempt(pm, running)) {
+        running->state = READY;
+        show_process_state(running->pid, "RUNNING", "READY");
+
+        if (current_core->arch_state) {
+            pthread_mutex_lock(&current_core->arch_state->global_mutex);
+            current_core->arch_state->context_switches++;
+            pthread_mutex_unlock(&current_core->arch_state->global_mutex);
+        }
+
+        // Mesmo caminho de retorno à fila usado na expiração de quantum
+        requeue_expired_process(pm, running);
+        release_core(cpu, core_id);
+    }
+
+    unlock_process_manager(pm);
+}
+
+// Controlador do quantum, chamado a cada QUANTUM_TUNE_INTERVAL ciclos.
+// Dobra o quantum quando as trocas estouram o orçamento e os bursts usam o
+// quantum inteiro (carga CPU-bound); reduz quando a resposta piora e ainda
+// há folga no orçamento. Só entram trocas forçadas (quantum expirado ou
+// preempção): carga inicial de registradores e stalls de colocação não são
+// overhead de troca.
+void tune_quantum(ProcessManager* pm) {
+    if (!pm || !ADAPTIVE_QUANTUM) return;
+
+    quantum_tuner* t = &pm->tuner;
+    // Custo medido pelo modelo de troca; estimativa fixa se desligado
+    int cost = CONTEXT_SWITCH_COST_ENABLED ? t->switch_cycles
+                                           : t->switches * QUANTUM_SWITCH_COST;
+
+    // Sem burst encerrado a janela não diz nada sobre o tamanho dos bursts
+    if (t->busy_cycles > 0 && t->bursts > 0) {
+        int quantum = pm->quantum_size;
+        float overhead = (float)cost / (t->busy_cycles + cost);
+        float avg_burst = (float)t->burst_cycles / t->bursts;
+        float avg_response = t->responses > 0 ? (float)t->response_sum / t->responses : 0.0f;
+
+        int new_quantum = quantum;
+        if (overhead > QUANTUM_OVERHEAD_BUDGET && avg_burst >= quantum) {
+            new_quantum = quantum * 2;
+        } else if (avg_response > QUANTUM_RESPONSE_TARGET &&
+                   overhead <= QUANTUM_OVERHEAD_BUDGET / 2) {
+            new_quantum = quantum - 1;
+        }
+
+        if (new_quantum < QUANTUM_MIN) new_quantum = QUANTUM_MIN;
+        if (new_quantum > QUANTUM_MAX) new_quantum = QUANTUM_MAX;
+
+        if (new_quantum != quantum) {
+            printf("\n[Quantum] Ajuste no ciclo %d: %d -> %d "
+                   "(overhead %.1f%%, burst médio %.1f, resposta média %.1f)",
+                   pm->current_time, quantum, new_quantum,
+                   overhead * 100, avg_burst, avg_response);
+            pm->quantum_size = new_quantum;
+            t->adjustments++;
+        }
+    }
+
+    t->switches = 0;
+    t->switch_cycles = 0;
+    t->busy_cycles = 0;
+    t->burst_cycles = 0;
+    t->bursts = 0;
+    t->response_sum = 0;
+    t->responses = 0;
+}
+
 void lock_process_manager(ProcessManager* pm) {
     pthread_mutex_lock(&pm->queue_mutex);
 }
@@ -7,7 +7,7 @@
 #include "cpu.h" 
 #include "ram.h"
 #include "policies/policy.h"
-#include "tlb.h"
+#include "sim_random.h"
 
 typedef enum {
     NEW,
@@ -18,66 +18,166 @@ typedef enum {
 } process_state;
 
 struct Policy;
+struct page_table_entry;
+
+// Nó da árvore rubro-negra do CFS, embutido no PCB (sem alocação por inserção)
+typedef struct cfs_node {
+    struct cfs_node* left;
+    struct cfs_node* right;
+    struct cfs_node* parent;
+    bool red;
+    PCB* owner;
+} cfs_node;
+
+// Observações de uma janela do ajuste de quantum
+typedef struct quantum_tuner {
+    int switches;       // Trocas por quantum expirado ou preempção na janela
+    int switch_cycles;  // Custo dessas trocas (salvar + restaurar contexto)
+    int busy_cycles;    // Ciclos-core ocupados na janela
+    int burst_cycles;   // Soma dos bursts encerrados na janela
+    int bursts;
+    int response_sum;   // Respostas de processos despachados pela 1a vez
+    int responses;
+    int adjustments;    // Total de mudanças de quantum
+} quantum_tuner;
 
 typedef struct ProcessManager {
     PCB** ready_queue;
     PCB** blocked_queue;
     int ready_count;
     int blocked_count;
+    int queue_capacity;  // Capacidade de ready_queue e blocked_queue
     int quantum_size;
     int current_time;
     struct Policy* policy;
     struct cpu* cpu;  
+    sim_rng rng;      // Gerador do simulador (sorteios reprodutíveis)
+    float admitted_utilization; // Soma de C/T dos processos admitidos (EDF)
+    float admitted_max_utilization; // Maior C/T entre os admitidos (EDF)
+    int admitted_count;         // Admitidos ainda no sistema (EDF)
+    int rejected_processes;     // Recusados pelo controle de admissão
+    quantum_tuner tuner;
     pthread_mutex_t queue_mutex;
     pthread_mutex_t resource_mutex;
     pthread_cond_t resource_condition;
 } ProcessManager;
 
+// Campos frios: contabilidade e metadados lidos na chegada, no término
+// ou no relatório final; ficam fora do bloco varrido pelo escalonador
+typedef struct pcb_cold {
+    char* resource_name;
+    bool using_io;
+    bool waiting_resource;
+    bool already_freed;
+    bool deadline_missed;
+    int total_instructions;
+    int lottery_selections;
+    int completion_time;
+    int start_time;
+    size_t program_size;
+    int waiting_time;      // Tempo total na fila de prontos
+    int response_time;     // Tempo até primeira execução
+    int turnaround_time;   // Tempo total no sistema
+    int migrations;        // Trocas de core entre despachos
+    int relative_deadline; // Prazo relativo em ciclos (0 = derivado da estimativa)
+    int period;            // Período de liberação (0 = aperiódico)
+    int arrival_time;      // Ciclo de chegada (trace de carga)
+    int priority;          // Prioridade do trace (1 = normal)
+    int cache_hits;        // Buscas de instrução atendidas pela cache
+    int cache_misses;
+    instruction_signature signature; // Tipos/hashes das instruções do programa
+} pcb_cold;
+
+// Campos quentes: lidos pelo escalonador a cada despacho ou varredura
 typedef struct PCB {
     int pid;
     process_state state;
     int core_id;
+    int quantum_remaining;
     unsigned short int PC;
-    unsigned short int* registers;
+    bool was_completed;
+    bool admitted;         // Aceito pelo controle de admissão
+    bool gang_dispatched;  // Despachado junto com seu grupo de similaridade
+    bool preempted;        // Perdeu o core por quantum ou preempção
+    int priority_level;    // Nível atual no MLFQ (0 = maior prioridade)
+    int current_burst;     // Instruções executadas no despacho atual
     int cycles_executed;
-    int quantum_remaining;
+    int last_scheduled;
+    int ready_since;       // Ciclo da última entrada na fila de prontos
+    int io_block_cycles;
+    float burst_estimate;  // Média exponencial dos bursts anteriores
+    int estimated_instructions; // Estimativa estática (laços expandidos)
+    int tickets;           // Tickets base da loteria
+    int compensation_tickets; // Bônus por não usar o quantum inteiro
+    int absolute_deadline; // Ciclo limite para término (-1 = sem prazo)
+    int similarity_group;  // Grupo persistente na política cache-aware (-1 = nenhum)
+    unsigned int context_version; // Incrementada a cada save_context
     unsigned int base_address;
     unsigned int memory_limit;
+    struct page_table_entry* page_table; // Páginas de dados (virtual_memory.h)
+    unsigned long vruntime; // Tempo virtual de execução (CFS)
+    unsigned short int* registers; // Banco de registradores no slab
+    pcb_cold* cold;        // Parte fria no slab
+    cfs_node run_node;     // Posição na árvore do CFS
+    struct PCB* next_free; // Encadeamento na free list do pool
+} PCB;
+
+// Métricas que o relatório final lê, por PID. Quem termina tem o PCB
+// devolvido ao pool e só o registro permanece; os demais são registrados
+// no fim da simulação.
+typedef struct process_record {
+    bool recorded;
     bool was_completed;
-    bool using_io;
-    int io_block_cycles;
-    bool waiting_resource;
-    char* resource_name;
+    bool admitted;
+    bool deadline_missed;
+    int pid;
+    int priority_level;
+    int tickets;
+    int absolute_deadline;
+    int estimated_instructions;
+    int cycles_executed;
+    float burst_estimate;
+    unsigned long vruntime;
+    size_t program_size;
     int total_instructions;
     int lottery_selections;
-    int last_scheduled;
-    // Adicionando completion_time
+    int arrival_time;
     int completion_time;
-    int start_time; 
-    bool already_freed;
-    size_t program_size;
-    int waiting_time;      // Tempo total na fila de prontos
-    int response_time;     // Tempo até primeira execução
-    int turnaround_time;   // Tempo total no sistema
-} PCB;
+    int response_time;
+    int waiting_time;
+    int turnaround_time;
+    int cache_hits;
+    int cache_misses;
+} process_record;
 
 // Funções do PCB
 PCB* create_pcb(void);
 void save_context(PCB* pcb, core* current_core);
-void restore_context(PCB* pcb, core* current_core);
+bool restore_context(PCB* pcb, core* current_core);
 void free_pcb(PCB* pcb);
+void record_process(PCB* pcb);
+void retire_pcb(PCB* pcb);
+void destroy_pcb_pool(void);
 char* get_program_content(PCB* pcb, ram* memory_ram);
 
 // Funções auxiliares
 const char* state_to_string(process_state state);
 
 // Variáveis globais
-extern PCB* all_processes[];
+extern PCB** all_processes;          // NULL após o PCB ser reciclado
+extern process_record* process_records;
 extern int total_processes;
 
+#define PCB_POOL_CHUNK 256  // PCBs alocados por bloco do slab
+
 // Funções do ProcessManager
 ProcessManager* init_process_manager(int quantum_size);
 void schedule_next_process(cpu* cpu, int core_id);
+void schedule_ready_processes(cpu* cpu);
+void enqueue_ready_process(ProcessManager* pm, PCB* process);
+void requeue_expired_process(ProcessManager* pm, PCB* process);
+void check_preemption(cpu* cpu, int core_id);
+void tune_quantum(ProcessManager* pm);
 void check_blocked_processes(cpu* cpu);
 int count_ready_processes(ProcessManager* pm);
 void lock_process_manager(ProcessManager* pm);
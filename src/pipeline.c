@@ -1,6 +1,8 @@
 #include "pipeline.h"
 #include "os_display.h"
 #include "instruction_utils.h"
+#include "cache_hierarchy.h"
+#include "virtual_memory.h"
 
 void init_pipeline(pipeline* p) {
     pthread_mutex_init(&p->pipeline_mutex, NULL);
@@ -28,18 +30,31 @@ static void handle_process_completion(architecture_state* state, cpu* cpu,
                                    char* instruction) {
     //printf("[Core %d] Processo %d finalizado\n", core_id, process->pid);
 
+    // Política fecha a contabilidade do processo (ex.: utilização do EDF)
+    if (cpu->process_manager->policy->on_process_complete) {
+        cpu->process_manager->policy->on_process_complete(cpu->process_manager, process);
+    }
+
     pthread_mutex_lock(&state->global_mutex);
     state->completed_processes++;
     pthread_mutex_unlock(&state->global_mutex);
 
+    // Região do programa e frames de dados voltam para a RAM (mutex da RAM já obtido)
+    ram_free(cpu->memory_ram, process->base_address,
+             process->memory_limit - process->base_address + 1);
+    release_address_space(cpu->memory_ram, process);
+    cache_untrack_region(process->pid);
+
     show_process_state(process->pid, "RUNNING", "FINISHED");
     process->state = FINISHED;
     process->was_completed = true;
     process->cycles_executed = cycle_count;
+    process->cold->completion_time = cycle_count;
+    process->cold->turnaround_time = cycle_count - process->cold->arrival_time;
 
-    lock_process_manager(cpu->process_manager);
+    // Lock do gerenciador já obtido pelo chamador
     release_core(cpu, core_id);
-    unlock_process_manager(cpu->process_manager);
+    retire_pcb(process);
 
     if (instruction) {
         free(instruction);
@@ -101,6 +116,16 @@ void execute_pipeline_cycle(architecture_state* state, cpu* cpu,
        return;
    }
 
+   // Core pagando penalidade (ex.: cache/TLB frios após migração)
+   if (current_core->stall_cycles > 0) {
+       current_core->stall_cycles--;
+       instruction_executed[core_id] = 1;
+       unlock_process_manager(cpu->process_manager);
+       pthread_mutex_unlock(&state->pipeline->pipeline_mutex);
+       pthread_mutex_unlock(&active_ram->mutex);
+       return;
+   }
+
    // Verifica fim do programa
    if (current_process->PC >= current_process->memory_limit) {
        printf("\n[Core %d] Processo %d: limite de memória atingido", core_id, current_process->pid);
@@ -119,25 +144,35 @@ void execute_pipeline_cycle(architecture_state* state, cpu* cpu,
 
    if (!instruction || strlen(instruction) == 0) {
        printf("\n[Core %d] Processo %d finalizado", core_id, current_process->pid);
-       current_process->state = FINISHED;
-       current_process->was_completed = true;
-       state->completed_processes++;
-
-       current_process->completion_time = cycle_count;
-       current_process->turnaround_time = cycle_count - current_process->start_time;
-
-       show_process_state(current_process->pid, "RUNNING", "FINISHED");
-
-       current_core->current_process = NULL;
-       current_core->is_available = true;
-       current_core->quantum_remaining = 0;
-
+       handle_process_completion(state, cpu, current_process, core_id, cycle_count, instruction);
        unlock_process_manager(cpu->process_manager);
        pthread_mutex_unlock(&state->pipeline->pipeline_mutex);
        pthread_mutex_unlock(&active_ram->mutex);
        return;
    }
 
+   // Busca da instrução passa pela cache quando habilitada
+   if (cache_enabled) {
+       unsigned int fetch_address = current_process->base_address + current_process->PC;
+       bool hit = check_cache(core_id, fetch_address, instruction);
+       if (hit) {
+           current_process->cold->cache_hits++;
+       } else {
+           current_process->cold->cache_misses++;
+           // Latência composta L2/LLC/memória atrasa as próximas instruções
+           int miss_latency = update_cache(core_id, fetch_address);
+           if (CACHE_STALLS_ENABLED) {
+               current_core->stall_cycles += miss_latency;
+               state->memory_stall_cycles += miss_latency;
+           }
+       }
+       record_gang_cache_access(current_process, hit);
+   } else if (CACHE_STALLS_ENABLED) {
+       // Sem cache toda busca vai à memória
+       current_core->stall_cycles += MEMORY_LATENCY;
+       state->memory_stall_cycles += MEMORY_LATENCY;
+   }
+
    // Executa estágios do pipeline
    type_of_instruction instr_type = decode_instruction(instruction);
 
@@ -157,7 +192,8 @@ void execute_pipeline_cycle(architecture_state* state, cpu* cpu,
    pthread_mutex_lock(&state->global_mutex);
    current_process->PC++;
    current_core->PC = current_process->PC;
-   current_process->total_instructions++;
+   current_process->cold->total_instructions++;
+   current_process->current_burst++;
    state->total_instructions++;
    pthread_mutex_unlock(&state->global_mutex);
 
@@ -183,7 +219,7 @@ void execute_pipeline_cycle(architecture_state* state, cpu* cpu,
        state->context_switches++;
        pthread_mutex_unlock(&state->global_mutex);
 
-       cpu->process_manager->policy->on_quantum_expired(cpu->process_manager, current_process);
+       requeue_expired_process(cpu->process_manager, current_process);
        release_core(cpu, core_id);
    }
 
@@ -2,62 +2,24 @@
 #include "../ram.h"
 #include "../libs.h"
 #include "../os_display.h"
+#include "../cache_events.h"
 #include <string.h>
 
 static int last_group_id = -1;
 
+// Gang scheduling: membros do grupo aguardando os demais cores livres
+static bool gang_mode = false;
+static PCB* gang_pending[NUM_CORES];  // No máximo um por core livre
+static int gang_pending_count = 0;
+static int gang_cycle = -1;
+
+// Acessos à cache separados por forma de despacho
+static long gang_hits = 0, gang_misses = 0;
+static long single_hits = 0, single_misses = 0;
+
 #define MAX_GROUPS 10
 #define SIMILARITY_THRESHOLD 0.7
 
-float calculate_instruction_similarity(const char* instr1, const char* instr2) {
-    if (!instr1 || !instr2) return 0.0f;
-    
-    // Buffer para armazenar até 5 instruções próximas
-    char instr1_buffer[5][50];
-    char instr2_buffer[5][50];
-    int count = 0;
-    float total_similarity = 0.0f;
-    
-    // Pegar próximas instruções
-    for(int i = 0; i < 5; i++) {
-        // Pegar próxima instrução do primeiro processo
-        const char* next1 = get_next_instruction(instr1, i);
-        if(next1) {
-            strncpy(instr1_buffer[count], next1, 49);
-            
-            // Pegar próxima instrução do segundo processo
-            const char* next2 = get_next_instruction(instr2, i);
-            if(next2) {
-                strncpy(instr2_buffer[count], next2, 49);
-                count++;
-            }
-        }
-    }
-    
-    // Comparar cada par de instruções
-    for(int i = 0; i < count; i++) {
-        // Extrair tipo da instrução
-        char type1[10], type2[10];
-        sscanf(instr1_buffer[i], "%s", type1);
-        sscanf(instr2_buffer[i], "%s", type2);
-        
-        // Instruções idênticas
-        if (strcmp(instr1_buffer[i], instr2_buffer[i]) == 0) {
-            total_similarity += 1.0f;
-        }
-        // Mesmo tipo de instrução
-        else if (strcmp(type1, type2) == 0) {
-            total_similarity += 0.8f;
-        }
-        // Operações similares (LOAD/STORE ou operações aritméticas)
-        else if (is_similar_operation(type1, type2)) {
-            total_similarity += 0.5f;
-        }
-    }
-    
-    return count > 0 ? total_similarity / count : 0.0f;
-}
-
 char* get_program_content(PCB* pcb, ram* memory_ram) {
     if (!pcb || !memory_ram || !memory_ram->vector) return NULL;
 
@@ -67,61 +29,199 @@ char* get_program_content(PCB* pcb, ram* memory_ram) {
     return memory_ram->vector + pcb->base_address;
 }
 
-void group_similar_processes(ProcessManager* pm, PCB** ready_queue, int ready_count, ProcessGroup* groups, int* group_count) {
-    printf("\n═══════════ Análise de Similaridade ═══════════");
-    *group_count = 0;
+static bool is_memory_type(type_of_instruction type) {
+    return type == LOAD || type == STORE;
+}
 
-    for (int i = 0; i < ready_count; i++) {
-        if (!ready_queue[i]) continue;
+static bool is_arithmetic_type(type_of_instruction type) {
+    return type == ADD || type == SUB || type == MUL || type == DIV;
+}
 
-        char* curr_instr = get_program_content(ready_queue[i], pm->cpu->memory_ram);
-        if (!curr_instr) continue;
+// Prefixo comparado par a par: linha idêntica vale 1.0, mesmo tipo 0.8 e
+// operação similar (LOAD/STORE ou aritméticas) 0.5, na média das posições.
+// Combinado com a sobreposição dos histogramas de tipos (Jaccard ponderado).
+float signature_similarity(const instruction_signature* a, const instruction_signature* b) {
+    int count = a->prefix_length < b->prefix_length ? a->prefix_length : b->prefix_length;
+    float prefix_score = 0.0f;
+
+    for (int i = 0; i < count; i++) {
+        if (a->prefix_hashes[i] == b->prefix_hashes[i]) {
+            prefix_score += 1.0f;
+        } else if (a->prefix_types[i] == b->prefix_types[i]) {
+            prefix_score += 0.8f;
+        } else if ((is_memory_type(a->prefix_types[i]) && is_memory_type(b->prefix_types[i])) ||
+                   (is_arithmetic_type(a->prefix_types[i]) && is_arithmetic_type(b->prefix_types[i]))) {
+            prefix_score += 0.5f;
+        }
+    }
+    prefix_score = count > 0 ? prefix_score / count : 0.0f;
 
-        printf("\n\n[Processo P%d]", ready_queue[i]->pid);
-        printf("\n├── Instrução base: %s", curr_instr);
+    int overlap = 0, combined = 0;
+    for (int t = 0; t <= INVALID; t++) {
+        int ha = a->type_histogram[t], hb = b->type_histogram[t];
+        overlap += ha < hb ? ha : hb;
+        combined += ha > hb ? ha : hb;
+    }
+    float histogram_score = combined > 0 ? (float)overlap / combined : 0.0f;
 
-        bool added_to_group = false;
+    return prefix_score * 0.7f + histogram_score * 0.3f;
+}
 
-        for (int g = 0; g < *group_count; g++) {
-            float total_similarity = 0.0f;
+// Matriz de similaridade triangular por PID: a linha i guarda os pares
+// (i, j < i) quantizados em 0..255, calculados uma vez na chegada de i.
+static unsigned char** similarity_rows = NULL;
+static int similarity_capacity = 0;
 
-            printf("\n├── Análise Grupo %d:", g);
+// Grupos persistentes: atualizados só na chegada/término de processos
+static ProcessGroup persistent_groups[MAX_GROUPS];
 
-            for (int p = 0; p < groups[g].count; p++) {
-                char* group_instr = get_program_content(groups[g].processes[p], pm->cpu->memory_ram);
-                float sim_score = calculate_instruction_similarity(curr_instr, group_instr);
-                printf("\n│   ├── P%d: %.2f%% similar", groups[g].processes[p]->pid, sim_score * 100);
-                total_similarity += sim_score;
-            }
+// Fotografia dos grupos restrita aos prontos; buffers reaproveitados
+static ProcessGroup ready_groups[MAX_GROUPS];
 
-            float avg_similarity = groups[g].count > 0 ?
-                                 total_similarity / groups[g].count : 0.0f;
+static bool group_append(ProcessGroup* group, PCB* process) {
+    if (group->count == group->capacity) {
+        int capacity = group->capacity ? group->capacity * 2 : INITIAL_PROCESS_CAPACITY;
+        PCB** processes = realloc(group->processes, capacity * sizeof(PCB*));
+        if (!processes) return false;
+        group->processes = processes;
+        group->capacity = capacity;
+    }
 
-            printf("\n│   └── Média do grupo: %.2f%%", avg_similarity * 100);
+    group->processes[group->count++] = process;
+    return true;
+}
+
+static float cached_similarity(PCB* a, PCB* b) {
+    if (a == b) return 1.0f;
+    int hi = a->pid > b->pid ? a->pid : b->pid;
+    int lo = a->pid > b->pid ? b->pid : a->pid;
+    if (hi >= similarity_capacity || !similarity_rows[hi]) return 0.0f;
+    return similarity_rows[hi][lo] / 255.0f;
+}
+
+static void register_process_similarity(PCB* process) {
+    int pid = process->pid;
+
+    if (pid >= similarity_capacity) {
+        int new_capacity = similarity_capacity ? similarity_capacity : 8;
+        while (new_capacity <= pid) new_capacity *= 2;
+
+        unsigned char** rows = realloc(similarity_rows, new_capacity * sizeof(unsigned char*));
+        if (!rows) return;
+        for (int i = similarity_capacity; i < new_capacity; i++) rows[i] = NULL;
+        similarity_rows = rows;
+        similarity_capacity = new_capacity;
+    }
 
-            if (avg_similarity >= SIMILARITY_THRESHOLD) {
-                groups[g].processes[groups[g].count++] = ready_queue[i];
-                groups[g].similarity_score = avg_similarity;
-                added_to_group = true;
-                printf("\n└── ✓ Incluído no Grupo %d", g);
-                break;
+    if (pid > 0 && !similarity_rows[pid]) {
+        similarity_rows[pid] = calloc(pid, sizeof(unsigned char));
+        if (!similarity_rows[pid]) return;
+    }
+
+    // Só pares com processos vivos precisam ser calculados
+    for (int g = 0; g < MAX_GROUPS; g++) {
+        for (int p = 0; p < persistent_groups[g].count; p++) {
+            PCB* other = persistent_groups[g].processes[p];
+            float score = signature_similarity(&process->cold->signature, &other->cold->signature);
+            int hi = pid > other->pid ? pid : other->pid;
+            int lo = pid > other->pid ? other->pid : pid;
+            if (similarity_rows[hi]) {
+                similarity_rows[hi][lo] = (unsigned char)(score * 255.0f + 0.5f);
             }
         }
+    }
+
+    // Entra no primeiro grupo com similaridade média acima do limiar;
+    // sem vaga para novo grupo, entra no mais parecido
+    int best_group = -1, empty_group = -1;
+    float best_avg = -1.0f;
+    for (int g = 0; g < MAX_GROUPS; g++) {
+        ProcessGroup* group = &persistent_groups[g];
+        if (group->count == 0) {
+            if (empty_group == -1) empty_group = g;
+            continue;
+        }
+
+        float total = 0.0f;
+        for (int p = 0; p < group->count; p++) {
+            total += cached_similarity(process, group->processes[p]);
+        }
+        float avg = total / group->count;
+
+        if (avg >= SIMILARITY_THRESHOLD) {
+            best_group = g;
+            best_avg = avg;
+            break;
+        }
+        if (avg > best_avg) {
+            best_avg = avg;
+            best_group = g;
+        }
+    }
+
+    if ((best_group == -1 || best_avg < SIMILARITY_THRESHOLD) && empty_group != -1) {
+        best_group = empty_group;
+        best_avg = 1.0f;
+    }
+    if (best_group == -1) return;
+
+    ProcessGroup* group = &persistent_groups[best_group];
+    if (!group_append(group, process)) return;
+    group->similarity_score = best_avg;
+    process->similarity_group = best_group;
+
+    printf("\n[Similaridade] P%d → Grupo %d (%.2f%%)", pid, best_group, best_avg * 100);
+}
+
+static void unregister_process_similarity(PCB* process) {
+    int g = process->similarity_group;
+    if (g < 0 || g >= MAX_GROUPS) return;
+
+    ProcessGroup* group = &persistent_groups[g];
+    for (int p = 0; p < group->count; p++) {
+        if (group->processes[p] == process) {
+            group->processes[p] = group->processes[--group->count];
+            break;
+        }
+    }
+    process->similarity_group = -1;
+
+    if (process->pid < similarity_capacity && similarity_rows[process->pid]) {
+        free(similarity_rows[process->pid]);
+        similarity_rows[process->pid] = NULL;
+    }
+}
+
+// Fotografia dos grupos persistentes restrita aos processos prontos;
+// o índice do grupo é o id persistente (grupos vazios têm count 0)
+void group_similar_processes(ProcessManager* pm, PCB** ready_queue, int ready_count, ProcessGroup* groups, int* group_count) {
+    (void)pm;
+    *group_count = MAX_GROUPS;
 
-        if (!added_to_group && *group_count < MAX_GROUPS) {
-            int new_group = *group_count;
-            groups[new_group].processes[0] = ready_queue[i];
-            groups[new_group].count = 1;
-            groups[new_group].similarity_score = 1.0f;
-            (*group_count)++;
-            printf("\n└── ★ Novo Grupo %d criado", new_group);
+    for (int g = 0; g < MAX_GROUPS; g++) {
+        groups[g].count = 0;
+        groups[g].similarity_score = persistent_groups[g].similarity_score;
+    }
+
+    for (int i = 0; i < ready_count; i++) {
+        PCB* process = ready_queue[i];
+        if (!process) continue;
+        if (process->similarity_group < 0) register_process_similarity(process);
+
+        int g = process->similarity_group;
+        if (g >= 0) {
+            group_append(&groups[g], process);
         }
     }
 
-    printf("\n\n═══════════ Sumário dos Grupos ═══════════");
-    for (int g = 0; g < *group_count; g++) {
+    // Impresso a cada seleção: só com o trace de eventos da cache
+    if (!CACHE_EVENT_TRACE) return;
+
+    printf("\n═══════════ Grupos de Similaridade ═══════════");
+    for (int g = 0; g < MAX_GROUPS; g++) {
+        if (groups[g].count == 0) continue;
         printf("\n┌── Grupo %d", g);
-        printf("\n├── Processos: ");
+        printf("\n├── Prontos: ");
         for (int p = 0; p < groups[g].count; p++) {
             printf("P%d ", groups[g].processes[p]->pid);
         }
@@ -130,10 +230,70 @@ void group_similar_processes(ProcessManager* pm, PCB** ready_queue, int ready_co
     printf("\n═════════════════════════════════════");
 }
 
+static int find_in_ready_queue(ProcessManager* pm, PCB* process) {
+    for (int i = 0; i < pm->ready_count; i++) {
+        if (pm->ready_queue[i] == process) return i;
+    }
+    return -1;
+}
+
+static void remove_from_ready_queue(ProcessManager* pm, int idx) {
+    for (int i = idx; i < pm->ready_count - 1; i++) {
+        pm->ready_queue[i] = pm->ready_queue[i + 1];
+    }
+    pm->ready_count--;
+}
+
+// Próximo membro do gang formado neste ciclo que ainda está pronto
+static PCB* pop_gang_member(ProcessManager* pm) {
+    while (gang_pending_count > 0) {
+        PCB* member = gang_pending[--gang_pending_count];
+        int idx = find_in_ready_queue(pm, member);
+        if (idx < 0) continue;
+
+        remove_from_ready_queue(pm, idx);
+        member->quantum_remaining = pm->quantum_size;
+        member->state = RUNNING;
+        member->gang_dispatched = true;
+
+        printf("\n[Gang] P%d co-escalonado com o grupo %d", member->pid, last_group_id);
+        return member;
+    }
+    return NULL;
+}
+
+void record_gang_cache_access(PCB* process, bool hit) {
+    if (!process) return;
 
+    if (process->gang_dispatched) {
+        if (hit) gang_hits++; else gang_misses++;
+    } else {
+        if (hit) single_hits++; else single_misses++;
+    }
+}
+
+void print_gang_cache_delta(void) {
+    if (!gang_mode) return;
+
+    long gang_total = gang_hits + gang_misses;
+    long single_total = single_hits + single_misses;
+    float gang_ratio = gang_total > 0 ? (float)gang_hits / gang_total * 100 : 0.0f;
+    float single_ratio = single_total > 0 ? (float)single_hits / single_total * 100 : 0.0f;
+
+    printf("\n\n[Gang Scheduling x Seleção Individual]");
+    printf("\n┌── Co-escalonados: %.1f%% hits (%ld acessos)", gang_ratio, gang_total);
+    printf("\n├── Individuais: %.1f%% hits (%ld acessos)", single_ratio, single_total);
+    printf("\n└── Delta de Hit Ratio: %+.1f p.p.", gang_ratio - single_ratio);
+}
 
 PCB* cache_aware_select_next(ProcessManager* pm) {
     if (!pm || pm->ready_count == 0 || !pm->cpu || !pm->cpu->memory_ram) return NULL;
+
+    // Cores restantes do mesmo ciclo vão para os membros do gang
+    if (gang_mode && gang_cycle == pm->current_time) {
+        PCB* member = pop_gang_member(pm);
+        if (member) return member;
+    }
     
     int core_id = -1;
     for(int i = 0; i < NUM_CORES; i++) {
@@ -154,21 +314,16 @@ PCB* cache_aware_select_next(ProcessManager* pm) {
         // Configura o processo selecionado
         selected->quantum_remaining = pm->quantum_size;
         selected->state = RUNNING;
-        selected->core_id = core_id;
-        pm->cpu->core[core_id].is_available = false;
-        pm->cpu->core[core_id].current_process = selected;
+        selected->gang_dispatched = false;
         
         // Remove da fila de prontos
-        for(int i = 0; i < pm->ready_count - 1; i++) {
-            pm->ready_queue[i] = pm->ready_queue[i + 1];
-        }
-        pm->ready_count--;
+        remove_from_ready_queue(pm, 0);
         
         return selected;
     }
 
     // Agrupar processos similares
-    ProcessGroup groups[MAX_GROUPS];
+    ProcessGroup* groups = ready_groups;
     int group_count;
     group_similar_processes(pm, pm->ready_queue, pm->ready_count, groups, &group_count);
 
@@ -233,12 +388,14 @@ PCB* cache_aware_select_next(ProcessManager* pm) {
         printf("\n├── Métricas:");
         printf("\n│   ├── Score Final: %.2f%%", best_score);
 
-        int cache_idx = selected->base_address % CACHE_SIZE;
-        printf("\n│   ├── Hit Ratio: %.2f%%", cache[cache_idx].hit_ratio * 100);
-        printf("\n│   ├── Prefetch Accuracy: %.2f%%", cache[cache_idx].prefetch_accuracy * 100);
+        int accesses = selected->cold->cache_hits + selected->cold->cache_misses;
+        printf("\n│   ├── Hit Ratio: %.2f%%",
+               accesses > 0 ? (float)selected->cold->cache_hits * 100 / accesses : 0.0f);
+        printf("\n│   ├── Blocos na cache: %.2f%%",
+               cache_region_resident_fraction(selected->pid) * 100);
         printf("\n│   └── Similaridade do Grupo: %.2f%%", groups[selected_group].similarity_score * 100);
 
-        printf("\n└── Core Atribuído: %d", core_id);
+        printf("\n└── Core livre: %d", core_id);
         printf("\n═════════════════════════════════════");
         
         // Atualizar grupo atual
@@ -247,31 +404,60 @@ PCB* cache_aware_select_next(ProcessManager* pm) {
         // Configurar processo selecionado
         selected->quantum_remaining = pm->quantum_size;
         selected->state = RUNNING;
-        selected->core_id = core_id;
-        pm->cpu->core[core_id].is_available = false;
-        pm->cpu->core[core_id].current_process = selected;
+        selected->gang_dispatched = false;
+
+        // Reservar os demais cores livres para o restante do grupo
+        if (gang_mode) {
+            int free_cores = 0;
+            for (int i = 0; i < NUM_CORES; i++) {
+                if (pm->cpu->core[i].is_available) free_cores++;
+            }
+
+            gang_pending_count = 0;
+            gang_cycle = pm->current_time;
+            ProcessGroup* group = &groups[selected_group];
+            for (int p = 0; p < group->count && gang_pending_count < free_cores - 1; p++) {
+                if (group->processes[p] != selected) {
+                    gang_pending[gang_pending_count++] = group->processes[p];
+                }
+            }
+            selected->gang_dispatched = gang_pending_count > 0;
+        }
 
-        // Atualizar cache com o conteúdo correto
+        // Aquecer a LLC com o primeiro bloco do programa (o core ainda não é conhecido)
         char* program_content = get_program_content(selected, pm->cpu->memory_ram);
         if (program_content) {
-            update_cache(selected->base_address, program_content);
+            cache_warm_block(selected->base_address);
         } else {
             printf("\n[Cache] Aviso: Não foi possível obter conteúdo do programa");
         }
 
         // Remover da fila de prontos
-        for(int i = selected_idx; i < pm->ready_count - 1; i++) {
-            pm->ready_queue[i] = pm->ready_queue[i + 1];
-        }
-        pm->ready_count--;
+        remove_from_ready_queue(pm, selected_idx);
         
-        printf("\n[Cache] P%d atribuído ao core %d (score: %.2f, grupo: %d)", 
-               selected->pid, core_id, best_score, selected_group);
+        printf("\n[Cache] P%d selecionado (score: %.2f, grupo: %d)", 
+               selected->pid, best_score, selected_group);
     }
 
     return selected;
 }
 
+void cache_aware_on_process_ready(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    if (process->similarity_group < 0) {
+        register_process_similarity(process);
+    }
+    pm->ready_queue[pm->ready_count++] = process;
+}
+
+void cache_aware_on_process_complete(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    unregister_process_similarity(process);
+    rr_on_process_complete(pm, process);
+}
+
 Policy* create_cache_aware_policy() {
     Policy* policy = malloc(sizeof(Policy));
     if(!policy) return NULL;
@@ -283,8 +469,34 @@ Policy* create_cache_aware_policy() {
     policy->is_preemptive = true;
     policy->select_next = cache_aware_select_next;
     policy->on_quantum_expired = rr_on_quantum_expired;
-    policy->on_process_complete = rr_on_process_complete;
+    policy->on_process_complete = cache_aware_on_process_complete;
+    policy->on_process_ready = cache_aware_on_process_ready;
+    policy->should_preempt = NULL;
     
+    gang_mode = false;
+    for (int g = 0; g < MAX_GROUPS; g++) {
+        persistent_groups[g].count = 0;
+        persistent_groups[g].similarity_score = 0.0f;
+    }
     init_cache();
+    return policy;
+}
+
+Policy* create_gang_policy(void) {
+    Policy* policy = create_cache_aware_policy();
+    if (!policy) return NULL;
+
+    policy->name = "Cache-Aware Gang Scheduling";
+    gang_mode = true;
+
+    // Sem cache não há grupos de similaridade: a seleção vira RR simples
+    if (!cache_enabled) {
+        printf("\n%s[Gang] Aviso: cache desabilitada, nenhum grupo é formado e o "
+               "escalonamento cai para Round Robin%s", COLOR_YELLOW, COLOR_RESET);
+    }
+    gang_pending_count = 0;
+    gang_cycle = -1;
+    gang_hits = gang_misses = single_hits = single_misses = 0;
+
     return policy;
 }
\ No newline at end of file
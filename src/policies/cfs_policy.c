@@ -0,0 +1,293 @@
+#include "policy.h"
+#include "../libs.h"
+#include "../os_display.h"
+
+// Árvore rubro-negra ordenada por (vruntime, pid); o nó mais à esquerda
+// fica em cache para seleção O(1), inserção/remoção são O(log n).
+static cfs_node* cfs_root = NULL;
+static cfs_node* cfs_leftmost = NULL;
+static unsigned long min_vruntime = 0;
+
+static bool cfs_less(const PCB* a, const PCB* b) {
+    if (a->vruntime != b->vruntime) return a->vruntime < b->vruntime;
+    return a->pid < b->pid;
+}
+
+static bool is_red(cfs_node* node) {
+    return node && node->red;
+}
+
+static void rotate_left(cfs_node* x) {
+    cfs_node* y = x->right;
+    x->right = y->left;
+    if (y->left) y->left->parent = x;
+
+    y->parent = x->parent;
+    if (!x->parent) cfs_root = y;
+    else if (x == x->parent->left) x->parent->left = y;
+    else x->parent->right = y;
+
+    y->left = x;
+    x->parent = y;
+}
+
+static void rotate_right(cfs_node* x) {
+    cfs_node* y = x->left;
+    x->left = y->right;
+    if (y->right) y->right->parent = x;
+
+    y->parent = x->parent;
+    if (!x->parent) cfs_root = y;
+    else if (x == x->parent->right) x->parent->right = y;
+    else x->parent->left = y;
+
+    y->right = x;
+    x->parent = y;
+}
+
+static void cfs_insert(cfs_node* node) {
+    cfs_node* parent = NULL;
+    cfs_node** link = &cfs_root;
+    bool leftmost = true;
+
+    while (*link) {
+        parent = *link;
+        if (cfs_less(node->owner, parent->owner)) {
+            link = &parent->left;
+        } else {
+            link = &parent->right;
+            leftmost = false;
+        }
+    }
+
+    node->left = node->right = NULL;
+    node->parent = parent;
+    node->red = true;
+    *link = node;
+    if (leftmost) cfs_leftmost = node;
+
+    // Rebalanceamento após inserção
+    while (node != cfs_root && is_red(node->parent)) {
+        cfs_node* grand = node->parent->parent;
+        if (node->parent == grand->left) {
+            cfs_node* uncle = grand->right;
+            if (is_red(uncle)) {
+                node->parent->red = false;
+                uncle->red = false;
+                grand->red = true;
+                node = grand;
+            } else {
+                if (node == node->parent->right) {
+                    node = node->parent;
+                    rotate_left(node);
+                }
+                node->parent->red = false;
+                grand->red = true;
+                rotate_right(grand);
+            }
+        } else {
+            cfs_node* uncle = grand->left;
+            if (is_red(uncle)) {
+                node->parent->red = false;
+                uncle->red = false;
+                grand->red = true;
+                node = grand;
+            } else {
+                if (node == node->parent->left) {
+                    node = node->parent;
+                    rotate_right(node);
+                }
+                node->parent->red = false;
+                grand->red = true;
+                rotate_left(grand);
+            }
+        }
+    }
+    cfs_root->red = false;
+}
+
+static cfs_node* tree_minimum(cfs_node* node) {
+    while (node && node->left) node = node->left;
+    return node;
+}
+
+static void transplant(cfs_node* u, cfs_node* v) {
+    if (!u->parent) cfs_root = v;
+    else if (u == u->parent->left) u->parent->left = v;
+    else u->parent->right = v;
+    if (v) v->parent = u->parent;
+}
+
+static void cfs_erase(cfs_node* node) {
+    if (node == cfs_leftmost) {
+        // Sucessor em ordem: mínimo da subárvore direita ou o pai
+        cfs_leftmost = node->right ? tree_minimum(node->right) : node->parent;
+    }
+
+    cfs_node* y = node;
+    bool y_was_red = y->red;
+    cfs_node* x;
+    cfs_node* x_parent;
+
+    if (!node->left) {
+        x = node->right;
+        x_parent = node->parent;
+        transplant(node, node->right);
+    } else if (!node->right) {
+        x = node->left;
+        x_parent = node->parent;
+        transplant(node, node->left);
+    } else {
+        y = tree_minimum(node->right);
+        y_was_red = y->red;
+        x = y->right;
+        if (y->parent == node) {
+            x_parent = y;
+        } else {
+            x_parent = y->parent;
+            transplant(y, y->right);
+            y->right = node->right;
+            y->right->parent = y;
+        }
+        transplant(node, y);
+        y->left = node->left;
+        y->left->parent = y;
+        y->red = node->red;
+    }
+
+    node->left = node->right = node->parent = NULL;
+    if (y_was_red) return;
+
+    // Rebalanceamento após remoção (x pode ser NULL = folha preta)
+    while (x != cfs_root && !is_red(x)) {
+        if (x == x_parent->left) {
+            cfs_node* w = x_parent->right;
+            if (is_red(w)) {
+                w->red = false;
+                x_parent->red = true;
+                rotate_left(x_parent);
+                w = x_parent->right;
+            }
+            if (!is_red(w->left) && !is_red(w->right)) {
+                w->red = true;
+                x = x_parent;
+                x_parent = x->parent;
+            } else {
+                if (!is_red(w->right)) {
+                    if (w->left) w->left->red = false;
+                    w->red = true;
+                    rotate_right(w);
+                    w = x_parent->right;
+                }
+                w->red = x_parent->red;
+                x_parent->red = false;
+                if (w->right) w->right->red = false;
+                rotate_left(x_parent);
+                x = cfs_root;
+            }
+        } else {
+            cfs_node* w = x_parent->left;
+            if (is_red(w)) {
+                w->red = false;
+                x_parent->red = true;
+                rotate_right(x_parent);
+                w = x_parent->left;
+            }
+            if (!is_red(w->right) && !is_red(w->left)) {
+                w->red = true;
+                x = x_parent;
+                x_parent = x->parent;
+            } else {
+                if (!is_red(w->left)) {
+                    if (w->right) w->right->red = false;
+                    w->red = true;
+                    rotate_left(w);
+                    w = x_parent->left;
+                }
+                w->red = x_parent->red;
+                x_parent->red = false;
+                if (w->left) w->left->red = false;
+                rotate_right(x_parent);
+                x = cfs_root;
+            }
+        }
+    }
+    if (x) x->red = false;
+}
+
+// Timeslice proporcional: o período alvo dividido pelos executáveis
+static int cfs_timeslice(ProcessManager* pm) {
+    int runnable = pm->ready_count + 1;
+    for (int i = 0; i < NUM_CORES; i++) {
+        if (!pm->cpu->core[i].is_available) runnable++;
+    }
+
+    int slice = CFS_TARGET_LATENCY / runnable;
+    return slice < CFS_MIN_GRANULARITY ? CFS_MIN_GRANULARITY : slice;
+}
+
+PCB* cfs_select_next(ProcessManager* pm) {
+    if (!pm || pm->ready_count == 0 || !cfs_leftmost) return NULL;
+
+    cfs_node* node = cfs_leftmost;
+    PCB* next = node->owner;
+    cfs_erase(node);
+    pm->ready_count--;
+
+    if (next->vruntime > min_vruntime) {
+        min_vruntime = next->vruntime;
+    }
+
+    next->quantum_remaining = cfs_timeslice(pm);
+
+    printf("%s[CFS] Executando P%d (vruntime: %lu, timeslice: %d)%s\n",
+           COLOR_BLUE, next->pid, next->vruntime, next->quantum_remaining, COLOR_RESET);
+    return next;
+}
+
+void cfs_on_process_ready(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    // Recém-chegados não podem acumular crédito sobre quem já executou
+    if (process->vruntime < min_vruntime) {
+        process->vruntime = min_vruntime;
+    }
+
+    cfs_insert(&process->run_node);
+    pm->ready_count++;
+}
+
+void cfs_on_quantum_expired(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    process->vruntime += process->current_burst;
+    process->state = READY;
+    cfs_on_process_ready(pm, process);
+}
+
+void cfs_on_process_complete(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    process->vruntime += process->current_burst;
+    rr_on_process_complete(pm, process);
+}
+
+Policy* create_cfs_policy(void) {
+    Policy* policy = malloc(sizeof(Policy));
+    if (!policy) return NULL;
+
+    cfs_root = NULL;
+    cfs_leftmost = NULL;
+    min_vruntime = 0;
+
+    policy->type = POLICY_CFS;
+    policy->name = "Completely Fair Scheduler";
+    policy->is_preemptive = true;
+    policy->select_next = cfs_select_next;
+    policy->on_quantum_expired = cfs_on_quantum_expired;
+    policy->on_process_complete = cfs_on_process_complete;
+    policy->on_process_ready = cfs_on_process_ready;
+    policy->should_preempt = NULL;
+
+    return policy;
+}
@@ -0,0 +1,154 @@
+#include "policy.h"
+#include "../libs.h"
+#include "../os_display.h"
+
+// Custo estimado (C) usado na admissão
+static int edf_cost(PCB* process) {
+    return process->estimated_instructions > 0 ? process->estimated_instructions : 1;
+}
+
+static bool edf_less(const PCB* a, const PCB* b) {
+    if (a->absolute_deadline != b->absolute_deadline) {
+        return a->absolute_deadline < b->absolute_deadline;
+    }
+    return a->pid < b->pid;
+}
+
+// Utilização (ou densidade, para aperiódicos) de um processo: C / T
+static float edf_utilization(PCB* process) {
+    int window = process->cold->period > 0 ? process->cold->period : process->cold->relative_deadline;
+    return window > 0 ? (float)edf_cost(process) / window : 1.0f;
+}
+
+// Parâmetros do trace; sem prazo, o período vira o prazo (prazo implícito)
+// e, sem nenhum dos dois, o prazo é derivado da estimativa na chegada
+void edf_set_deadline(PCB* process, int relative_deadline, int period) {
+    if (!process) return;
+    process->cold->period = period > 0 ? period : 0;
+    process->cold->relative_deadline = relative_deadline > 0 ? relative_deadline
+                                                             : process->cold->period;
+}
+
+// Teste de escalonabilidade do EDF global (limite GFB):
+// U_total <= m - (m - 1) * u_max
+// u_max acumulado só zera quando o conjunto admitido esvazia: o limite fica
+// conservador, sem varrer os processos a cada chegada
+static bool edf_admit(ProcessManager* pm, PCB* process) {
+    float u = edf_utilization(process);
+    float u_max = u > pm->admitted_max_utilization ? u : pm->admitted_max_utilization;
+
+    float total = pm->admitted_utilization + u;
+    float bound = NUM_CORES - (NUM_CORES - 1) * u_max;
+
+    if (total > bound) {
+        printf("\n[EDF] P%d recusado (U=%.2f, total %.2f > limite %.2f)",
+               process->pid, u, total, bound);
+        return false;
+    }
+
+    pm->admitted_utilization = total;
+    pm->admitted_max_utilization = u_max;
+    pm->admitted_count++;
+    printf("\n[EDF] P%d admitido (C=%d, D=%d, U=%.2f, total %.2f/%.2f)",
+           process->pid, edf_cost(process), process->cold->relative_deadline, u, total, bound);
+    return true;
+}
+
+PCB* edf_select_next(ProcessManager* pm) {
+    if (!pm || pm->ready_count == 0) return NULL;
+
+    PCB* next = ready_heap_pop(pm, edf_less);
+    next->quantum_remaining = pm->quantum_size;
+
+    printf("%s[EDF] Executando P%d (prazo: ciclo %d)%s\n",
+           COLOR_BLUE, next->pid, next->absolute_deadline, COLOR_RESET);
+    return next;
+}
+
+void edf_on_process_ready(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    // Primeira chegada: define prazo absoluto e passa pela admissão
+    if (process->absolute_deadline < 0) {
+        if (process->cold->relative_deadline <= 0) {
+            process->cold->relative_deadline = edf_cost(process) * EDF_DEADLINE_SLACK;
+        }
+        process->absolute_deadline = pm->current_time + process->cold->relative_deadline;
+
+        if (!edf_admit(pm, process)) {
+            pm->rejected_processes++;
+            process->state = FINISHED;
+            return;
+        }
+        process->admitted = true;
+    }
+
+    ready_heap_push(pm, process, edf_less);
+}
+
+void edf_on_quantum_expired(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    process->state = READY;
+    ready_heap_push(pm, process, edf_less);
+}
+
+// Preempta quando a raiz da heap tem prazo mais cedo que o processo em execução
+bool edf_should_preempt(ProcessManager* pm, PCB* running) {
+    if (!pm || pm->ready_count == 0 || !running) return false;
+    return pm->ready_queue[0]->absolute_deadline < running->absolute_deadline;
+}
+
+void edf_on_process_complete(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    if (process->admitted) {
+        pm->admitted_utilization -= edf_utilization(process);
+        if (pm->admitted_utilization < 0) pm->admitted_utilization = 0;
+        if (--pm->admitted_count <= 0) {
+            pm->admitted_count = 0;
+            pm->admitted_utilization = 0.0f;
+            pm->admitted_max_utilization = 0.0f;
+        }
+    }
+
+    if (pm->current_time > process->absolute_deadline && !process->cold->deadline_missed) {
+        process->cold->deadline_missed = true;
+        printf("\n[EDF] P%d perdeu o prazo (ciclo %d > %d)",
+               process->pid, pm->current_time, process->absolute_deadline);
+    }
+
+    rr_on_process_complete(pm, process);
+}
+
+// Conta perdas de prazo, incluindo processos ainda não concluídos cujo
+// prazo já passou no fim da simulação
+int count_deadline_misses(int current_time) {
+    int misses = 0;
+    for (int i = 0; i < total_processes; i++) {
+        process_record* process = &process_records[i];
+        if (!process->recorded || !process->admitted) continue;
+
+        if (!process->was_completed && current_time > process->absolute_deadline) {
+            process->deadline_missed = true;
+        }
+        if (process->deadline_missed) misses++;
+    }
+    return misses;
+}
+
+Policy* create_edf_policy(void) {
+    Policy* policy = malloc(sizeof(Policy));
+    if (!policy) return NULL;
+
+    policy->type = POLICY_EDF;
+    policy->name = "Earliest Deadline First";
+    policy->is_preemptive = true;
+    policy->select_next = edf_select_next;
+    policy->on_quantum_expired = edf_on_quantum_expired;
+    policy->on_process_complete = edf_on_process_complete;
+    policy->on_process_ready = edf_on_process_ready;
+    policy->should_preempt = edf_should_preempt;
+
+    return policy;
+}
@@ -1,60 +1,128 @@
 #include "policy.h"
 #include "../libs.h"
-#include <time.h>
 #include "../os_display.h"  
 
-// Inicializa o gerador de números aleatórios
-static void init_lottery() {
-    static bool initialized = false;
-    if (!initialized) {
-        srand(time(NULL));
-        initialized = true;
+// Fenwick tree indexada por PID (1-based): soma de prefixo dos tickets dos
+// processos prontos. Sorteio e atualização são O(log n).
+static int* ticket_tree = NULL;
+static int* ready_tickets = NULL;  // Tickets em jogo por PID (0 = fora)
+static int tree_size = 0;
+static int total_tickets = 0;
+
+// Dobra a árvore até cobrir o PID, reconstruindo-a em O(n)
+static bool ticket_tree_reserve(int pid) {
+    if (pid < tree_size) return true;
+
+    int size = tree_size ? tree_size : INITIAL_PROCESS_CAPACITY;
+    while (size <= pid) size *= 2;
+
+    int* tickets = realloc(ready_tickets, size * sizeof(int));
+    if (!tickets) return false;
+    memset(tickets + tree_size, 0, (size - tree_size) * sizeof(int));
+    ready_tickets = tickets;
+
+    int* tree = calloc(size + 1, sizeof(int));
+    if (!tree) return false;
+    for (int i = 1; i <= size; i++) {
+        tree[i] += ready_tickets[i - 1];
+        int parent = i + (i & -i);
+        if (parent <= size) tree[parent] += tree[i];
     }
+
+    free(ticket_tree);
+    ticket_tree = tree;
+    tree_size = size;
+    return true;
 }
 
-// Conta total de tickets disponíveis
-static int count_total_tickets(ProcessManager* pm) {
-    int total = 0;
-    for (int i = 0; i < pm->ready_count; i++) {
-        // Cada processo começa com tickets = pid + 1 para garantir pelo menos 1 ticket
-        total += (pm->ready_queue[i]->pid + 1);
+static void ticket_tree_add(int pid, int delta) {
+    for (int i = pid + 1; i <= tree_size; i += i & -i) {
+        ticket_tree[i] += delta;
     }
-    return total;
+    total_tickets += delta;
+}
+
+// Menor PID cuja soma de prefixo excede o ticket sorteado
+static int ticket_tree_find(int ticket) {
+    int pos = 0;
+    int step = 1;
+    while (step * 2 <= tree_size) step *= 2;
+
+    for (; step > 0; step /= 2) {
+        int next = pos + step;
+        if (next <= tree_size && ticket_tree[next] <= ticket) {
+            pos = next;
+            ticket -= ticket_tree[next];
+        }
+    }
+    return pos;  // índice 1-based do vencedor - 1 = PID
+}
+
+static int effective_tickets(PCB* process) {
+    int tickets = process->tickets + process->compensation_tickets;
+    return tickets > 0 ? tickets : 1;
+}
+
+// Reflete na árvore uma mudança de tickets de um processo já na fila
+static void refresh_ready_tickets(PCB* process) {
+    if (process->pid >= tree_size || ready_tickets[process->pid] == 0) return;
+
+    int tickets = effective_tickets(process);
+    ticket_tree_add(process->pid, tickets - ready_tickets[process->pid]);
+    ready_tickets[process->pid] = tickets;
 }
 
-        PCB* lottery_select_next(ProcessManager* pm) {
-    if (!pm || pm->ready_count == 0) return NULL;
+// Chamador segura o lock do gerenciador, como nos hooks da política (o
+// mutex não é recursivo). A admissão usa para os tickets da prioridade.
+void lottery_set_tickets(ProcessManager* pm, PCB* process, int tickets) {
+    if (!pm || !process || tickets <= 0) return;
+
+    process->tickets = tickets;
+    refresh_ready_tickets(process);
+}
+
+PCB* lottery_select_next(ProcessManager* pm) {
+    if (!pm || pm->ready_count == 0 || total_tickets <= 0) return NULL;
     
-    int total_tickets = count_total_tickets(pm);
-    if (total_tickets == 0) return NULL;
+    int pool = total_tickets;  // Faixa do sorteio, antes de o vencedor sair
+    int winning_ticket = sim_rng_range(&pm->rng, pool);
+    int pid = ticket_tree_find(winning_ticket);
+    if (pid < 0 || pid >= total_processes || !all_processes[pid]) return NULL;
+
+    PCB* winner = all_processes[pid];
+    ticket_tree_add(pid, -ready_tickets[pid]);
+    ready_tickets[pid] = 0;
+    pm->ready_count--;
+
+    winner->cold->lottery_selections++;
+    // Compensação vale apenas para o sorteio seguinte
+    winner->compensation_tickets = 0;
+
+    // Resetar quantum ao selecionar
+    winner->quantum_remaining = pm->quantum_size;
     
-    int winning_ticket = rand() % total_tickets;
+    printf("%s[Lottery] P%d ganhou o sorteio (ticket: %d/%d, quantum: %d)%s\n", 
+           COLOR_YELLOW, winner->pid, winning_ticket, pool,
+           winner->quantum_remaining, COLOR_RESET);
     
-    // Encontra processo vencedor
-    int current_sum = 0;
-    for (int i = 0; i < pm->ready_count; i++) {
-        current_sum += (pm->ready_queue[i]->pid + 1);  // tickets do processo
-        if (current_sum > winning_ticket) {
-            PCB* winner = pm->ready_queue[i];
-                winner->lottery_selections++;
-            // Remove da fila
-            for (int j = i; j < pm->ready_count - 1; j++) {
-                pm->ready_queue[j] = pm->ready_queue[j + 1];
-            }
-            pm->ready_count--;
-            
-            // Resetar quantum ao selecionar
-            winner->quantum_remaining = pm->quantum_size;
-            
-            printf("%s[Lottery] P%d ganhou o sorteio (ticket: %d, quantum: %d)%s\n", 
-                   COLOR_YELLOW, winner->pid, winning_ticket, winner->quantum_remaining, 
-                   COLOR_RESET);
-            
-            return winner;
-        }
+    return winner;
+}
+
+void lottery_on_process_ready(ProcessManager* pm, PCB* process) {
+    if (!pm || !process || !ticket_tree_reserve(process->pid) ||
+        ready_tickets[process->pid] != 0) return;
+
+    // Tickets de compensação: quem usou só uma fração f do quantum
+    // concorre com tickets/f até ser sorteado de novo
+    if (process->current_burst > 0 && process->current_burst < pm->quantum_size) {
+        process->compensation_tickets =
+            process->tickets * pm->quantum_size / process->current_burst - process->tickets;
     }
-    
-    return NULL;
+
+    int tickets = effective_tickets(process);
+    ready_tickets[process->pid] = tickets;
+    ticket_tree_add(process->pid, tickets);
+    pm->ready_count++;
 }
 
 void lottery_on_quantum_expired(ProcessManager* pm, PCB* process) {
@@ -63,19 +131,26 @@ void lottery_on_quantum_expired(ProcessManager* pm, PCB* process) {
     // Resetar quantum antes de retornar à fila
     process->quantum_remaining = pm->quantum_size;
     process->state = READY;
-    pm->ready_queue[pm->ready_count++] = process;
+    lottery_on_process_ready(pm, process);
 }
 
 
 void lottery_on_process_complete(ProcessManager* pm, PCB* process) {
     if (!pm || !process) return;
-    process->turnaround_time = pm->current_time - process->start_time;
+    process->cold->turnaround_time = pm->current_time - process->cold->arrival_time;
     process->state = FINISHED;
 }
 
 Policy* create_lottery_policy() {
     Policy* policy = malloc(sizeof(Policy));
     if (!policy) return NULL;
+
+    free(ticket_tree);
+    free(ready_tickets);
+    ticket_tree = NULL;
+    ready_tickets = NULL;
+    tree_size = 0;
+    total_tickets = 0;
     
     policy->type = POLICY_LOTTERY;
     policy->name = "Lottery Scheduling";
@@ -83,9 +158,8 @@ Policy* create_lottery_policy() {
     policy->select_next = lottery_select_next;
     policy->on_quantum_expired = lottery_on_quantum_expired;
     policy->on_process_complete = lottery_on_process_complete;
-    
-    // Inicializa o gerador de números aleatórios
-    init_lottery();
+    policy->on_process_ready = lottery_on_process_ready;
+    policy->should_preempt = NULL;
     
     return policy;
-}
\ No newline at end of file
+}
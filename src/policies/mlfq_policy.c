@@ -0,0 +1,143 @@
+#include "policy.h"
+#include "../libs.h"
+#include "../os_display.h"
+
+// Quantum de cada nível (nível 0 = maior prioridade), relativo a DEFAULT_QUANTUM
+static const int mlfq_quanta[MLFQ_LEVELS] = MLFQ_QUANTA;
+
+// Escala a tabela pelo quantum atual, que o ajuste adaptativo move
+static int mlfq_level_quantum(ProcessManager* pm, int level) {
+    int quantum = mlfq_quanta[level] * pm->quantum_size / DEFAULT_QUANTUM;
+    return quantum > 0 ? quantum : 1;
+}
+
+// Uma fila FIFO circular por nível, dobrada quando enche
+typedef struct {
+    PCB** processes;
+    int capacity;
+    int head;
+    int count;
+} MLFQLevel;
+
+static MLFQLevel mlfq_levels[MLFQ_LEVELS];
+static int last_boost_time = 0;
+
+// Realoca linearizando a partir de head
+static bool mlfq_grow(MLFQLevel* queue) {
+    int capacity = queue->capacity ? queue->capacity * 2 : INITIAL_PROCESS_CAPACITY;
+    PCB** processes = malloc(capacity * sizeof(PCB*));
+    if (!processes) return false;
+
+    for (int i = 0; i < queue->count; i++) {
+        processes[i] = queue->processes[(queue->head + i) % queue->capacity];
+    }
+    free(queue->processes);
+    queue->processes = processes;
+    queue->capacity = capacity;
+    queue->head = 0;
+    return true;
+}
+
+static void mlfq_push(int level, PCB* process) {
+    MLFQLevel* queue = &mlfq_levels[level];
+    if (queue->count == queue->capacity && !mlfq_grow(queue)) return;
+
+    queue->processes[(queue->head + queue->count) % queue->capacity] = process;
+    queue->count++;
+}
+
+static PCB* mlfq_pop(int level) {
+    MLFQLevel* queue = &mlfq_levels[level];
+    if (queue->count == 0) return NULL;
+
+    PCB* process = queue->processes[queue->head];
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    return process;
+}
+
+// Boost periódico: todos voltam ao nível 0 para evitar starvation
+static void mlfq_priority_boost(ProcessManager* pm) {
+    for (int level = 1; level < MLFQ_LEVELS; level++) {
+        PCB* process;
+        while ((process = mlfq_pop(level)) != NULL) {
+            process->priority_level = 0;
+            mlfq_push(0, process);
+        }
+    }
+
+    // Processos em execução também perdem o rebaixamento
+    for (int i = 0; i < total_processes; i++) {
+        if (all_processes[i] && all_processes[i]->state != FINISHED) {
+            all_processes[i]->priority_level = 0;
+        }
+    }
+
+    last_boost_time = pm->current_time;
+    printf("%s[MLFQ] Boost de prioridade no ciclo %d%s\n",
+           COLOR_MAGENTA, pm->current_time, COLOR_RESET);
+}
+
+PCB* mlfq_select_next(ProcessManager* pm) {
+    if (!pm || pm->ready_count == 0) return NULL;
+
+    if (pm->current_time - last_boost_time >= MLFQ_BOOST_INTERVAL) {
+        mlfq_priority_boost(pm);
+    }
+
+    for (int level = 0; level < MLFQ_LEVELS; level++) {
+        PCB* next = mlfq_pop(level);
+        if (!next) continue;
+
+        pm->ready_count--;
+        next->quantum_remaining = mlfq_level_quantum(pm, level);
+
+        printf("%s[MLFQ] Executando P%d (nível: %d, quantum: %d)%s\n",
+               COLOR_BLUE, next->pid, level, next->quantum_remaining, COLOR_RESET);
+        return next;
+    }
+
+    return NULL;
+}
+
+void mlfq_on_process_ready(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    mlfq_push(process->priority_level, process);
+    pm->ready_count++;
+}
+
+void mlfq_on_quantum_expired(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+
+    // Usou o quantum inteiro: desce um nível
+    if (process->priority_level < MLFQ_LEVELS - 1) {
+        process->priority_level++;
+        printf("\n[MLFQ] P%d rebaixado para o nível %d", process->pid, process->priority_level);
+    }
+
+    process->state = READY;
+    mlfq_on_process_ready(pm, process);
+}
+
+Policy* create_mlfq_policy(void) {
+    Policy* policy = malloc(sizeof(Policy));
+    if (!policy) return NULL;
+
+    for (int level = 0; level < MLFQ_LEVELS; level++) {
+        mlfq_levels[level].head = 0;
+        mlfq_levels[level].count = 0;
+    }
+    last_boost_time = 0;
+
+    policy->type = POLICY_MLFQ;
+    policy->name = "Multi-Level Feedback Queue";
+    policy->is_preemptive = true;
+    policy->select_next = mlfq_select_next;
+    policy->on_quantum_expired = mlfq_on_quantum_expired;
+    policy->on_process_complete = rr_on_process_complete;
+    policy->on_process_ready = mlfq_on_process_ready;
+    policy->should_preempt = NULL;
+
+    return policy;
+}
@@ -39,17 +39,65 @@ const char* get_next_instruction(const char* current, int offset) {
 }
 
 float calculate_process_cache_score(PCB* process, ProcessGroup* groups, int current_group) {
-    int idx = process->base_address % CACHE_SIZE;
-    
+    int accesses = process->cold->cache_hits + process->cold->cache_misses;
+    float hit_ratio = accesses > 0 ? (float)process->cold->cache_hits / accesses : 0.0f;
+
     // Hit ratio tem peso menor agora (40%)
-    float hit_ratio_factor = cache[idx].hit_ratio * 0.4f;
+    float hit_ratio_factor = hit_ratio * 0.4f;
     
     // Similaridade tem peso maior (40%)
     float similarity_factor = groups[current_group].similarity_score * 0.4f;
     
-    // Tempo de acesso (20%)
-    float recency_factor = 1.0f / (cache[idx].age + 1) * 0.2f;
+    // Blocos do programa ainda presentes na cache (20%)
+    float recency_factor = cache_region_resident_fraction(process->pid) * 0.2f;
     
     return (hit_ratio_factor + similarity_factor + recency_factor) * 100.0f;
 }
 
+
+static void ready_heap_swap(PCB** heap, int a, int b) {
+    PCB* tmp = heap[a];
+    heap[a] = heap[b];
+    heap[b] = tmp;
+}
+
+void ready_heap_push(ProcessManager* pm, PCB* process, ready_heap_less less) {
+    if (!pm || !process || !less) return;
+
+    PCB** heap = pm->ready_queue;
+    int i = pm->ready_count++;
+    heap[i] = process;
+
+    // Sobe enquanto tiver prioridade sobre o pai
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!less(heap[i], heap[parent])) break;
+        ready_heap_swap(heap, i, parent);
+        i = parent;
+    }
+}
+
+PCB* ready_heap_pop(ProcessManager* pm, ready_heap_less less) {
+    if (!pm || pm->ready_count == 0 || !less) return NULL;
+
+    PCB** heap = pm->ready_queue;
+    PCB* top = heap[0];
+    heap[0] = heap[--pm->ready_count];
+
+    // Desce trocando com o filho de maior prioridade
+    int i = 0;
+    while (true) {
+        int left = 2 * i + 1;
+        int right = left + 1;
+        int best = i;
+
+        if (left < pm->ready_count && less(heap[left], heap[best])) best = left;
+        if (right < pm->ready_count && less(heap[right], heap[best])) best = right;
+        if (best == i) break;
+
+        ready_heap_swap(heap, i, best);
+        i = best;
+    }
+
+    return top;
+}
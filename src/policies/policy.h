@@ -5,9 +5,25 @@
 
 #define MAX_GROUPS 10
 
+// Configuração do MLFQ
+#define MLFQ_LEVELS 3
+#define MLFQ_QUANTA {2, 4, 8}      // Quantum por nível
+#define MLFQ_BOOST_INTERVAL 20     // Ciclos entre boosts de prioridade
+
+// Configuração do CFS
+#define CFS_TARGET_LATENCY 20      // Período em que todos devem rodar uma vez
+#define CFS_MIN_GRANULARITY 1      // Timeslice mínimo em ciclos
+
+// Configuração do EDF
+#define EDF_DEADLINE_SLACK 3       // Prazo padrão = folga x instruções estimadas
+
+// Configuração da loteria
+#define LOTTERY_DEFAULT_TICKETS 100
+
 typedef struct {
-    PCB* processes[MAX_PROCESSES];  
+    PCB** processes;  // Cresce sob demanda (group_append)
     int count;
+    int capacity;
     float similarity_score;
 } ProcessGroup;
 
@@ -16,7 +32,11 @@ typedef enum {
     POLICY_RR,      
     POLICY_SJF,       
     POLICY_LOTTERY, 
-    POLICY_CACHE_AWARE
+    POLICY_CACHE_AWARE,
+    POLICY_SRTF,
+    POLICY_MLFQ,
+    POLICY_CFS,
+    POLICY_EDF
 } PolicyType;
 
 // Interface da política de escalonamento
@@ -27,8 +47,14 @@ typedef struct Policy {
     PCB* (*select_next)(struct ProcessManager* pm);
     void (*on_quantum_expired)(struct ProcessManager* pm, PCB* process);
     void (*on_process_complete)(struct ProcessManager* pm, PCB* process);
+    // Opcionais (NULL = comportamento padrão)
+    void (*on_process_ready)(struct ProcessManager* pm, PCB* process);
+    bool (*should_preempt)(struct ProcessManager* pm, PCB* running);
 } Policy;
 
+// Comparador da heap de prontos: true se a tem prioridade sobre b
+typedef bool (*ready_heap_less)(const PCB* a, const PCB* b);
+
 typedef struct {
     char* binary_pid;
     PCB* process;
@@ -41,15 +67,34 @@ Policy* create_rr_policy(void);
 Policy* create_sjf_policy(void);
 Policy* create_lottery_policy(void);
 Policy* create_cache_aware_policy(void);
+Policy* create_srtf_policy(void);
+Policy* create_mlfq_policy(void);
+Policy* create_cfs_policy(void);
+Policy* create_gang_policy(void);
+Policy* create_edf_policy(void);
 int get_program_length(PCB* process);
 void rr_on_quantum_expired(ProcessManager* pm, PCB* process);
 void rr_on_process_complete(ProcessManager* pm, PCB* process);
 float calculate_process_cache_score(PCB* process, ProcessGroup* groups, int current_group);
 
+// EDF: prazos por processo
+void edf_set_deadline(PCB* process, int relative_deadline, int period);
+int count_deadline_misses(int current_time);
+
+// Loteria: tickets por processo
+void lottery_set_tickets(ProcessManager* pm, PCB* process, int tickets);
+
+// Heap binária sobre pm->ready_queue (O(log n) por inserção/remoção)
+void ready_heap_push(ProcessManager* pm, PCB* process, ready_heap_less less);
+PCB* ready_heap_pop(ProcessManager* pm, ready_heap_less less);
+int sjf_remaining_estimate(const PCB* process);
+
 // Funções para cache-aware policy
 void group_similar_processes(ProcessManager* pm, PCB** ready_queue, int ready_count, ProcessGroup* groups, int* group_count);
 
-float calculate_instruction_similarity(const char* instr1, const char* instr2);
+float signature_similarity(const instruction_signature* a, const instruction_signature* b);
+void record_gang_cache_access(PCB* process, bool hit);
+void print_gang_cache_delta(void);
 
 bool is_similar_operation(const char* type1, const char* type2);
 const char* get_next_instruction(const char* current, int offset);
@@ -21,6 +21,21 @@ Policy* select_scheduling_policy(void) {
         case 4:  // Add this case
             policy = create_cache_aware_policy();
             break;
+        case 5:
+            policy = create_srtf_policy();
+            break;
+        case 6:
+            policy = create_mlfq_policy();
+            break;
+        case 7:
+            policy = create_cfs_policy();
+            break;
+        case 8:
+            policy = create_gang_policy();
+            break;
+        case 9:
+            policy = create_edf_policy();
+            break;
         default:
             printf("\n[Política] ERRO: Opção inválida");
             exit(1);
@@ -41,7 +41,7 @@ void rr_on_process_complete(ProcessManager* pm, PCB* process) {
     // Marca processo como finalizado
     process->state = FINISHED;
     process->was_completed = true;
-    process->completion_time = process->cycles_executed;
+    process->cold->completion_time = process->cycles_executed;
 }
 
 Policy* create_rr_policy() {
@@ -54,6 +54,8 @@ Policy* create_rr_policy() {
     policy->select_next = rr_select_next;
     policy->on_quantum_expired = rr_on_quantum_expired;
     policy->on_process_complete = rr_on_process_complete;
+    policy->on_process_ready = NULL;
+    policy->should_preempt = NULL;
     
     return policy;
-}
\ No newline at end of file
+}
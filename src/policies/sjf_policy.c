@@ -11,90 +11,94 @@ int get_program_length(PCB* process) {
     // Considerando que cada instrução ocupa aproximadamente 25 bytes (em média)
     return (program_size / 25) + 1; // +1 para garantir no mínimo 1 instrução
 }
-PCB* find_process_by_binary_pid(ProcessManager* pm, const char* binary_pid) {
-    for (int i = 0; i < pm->ready_count; i++) {
-        char* current_binary = lookup_pid_in_tlb(pm->ready_queue[i]->pid);
-        if (current_binary && strcmp(current_binary, binary_pid) == 0) {
-            return pm->ready_queue[i];
-        }
-    }
-    return NULL;
+// Peso do último burst na média exponencial (tau = a*t + (1-a)*tau)
+#define BURST_ALPHA 0.5f
+
+int sjf_remaining_estimate(const PCB* process) {
+    if (!process) return 0;
+
+    int remaining = process->estimated_instructions - process->cold->total_instructions;
+    if (remaining > 0) return remaining;
+
+    // Estimativa estática esgotada: usa a média dos bursts anteriores
+    return (int)(process->burst_estimate + 0.5f);
 }
-PCB* sjf_select_next(ProcessManager* pm) {
-    if (!pm || pm->ready_count == 0) return NULL;
 
-    int shortest_idx = 0;
-    int shortest_size = pm->ready_queue[0]->program_size;
+static bool sjf_less(const PCB* a, const PCB* b) {
+    int remaining_a = sjf_remaining_estimate(a);
+    int remaining_b = sjf_remaining_estimate(b);
 
-    printf("\n[SJF] Analisando processos usando PID binário:");
-    for (int i = 0; i < pm->ready_count; i++) {
-        int size = pm->ready_queue[i]->program_size;
-        char* binary_pid = lookup_pid_in_tlb(pm->ready_queue[i]->pid);
+    if (remaining_a != remaining_b) return remaining_a < remaining_b;
+    return a->pid < b->pid;
+}
 
-        printf("\n - Processo PID(bin):%s: %d bytes",
-               binary_pid ? binary_pid : "N/A", size);
+static void sjf_update_burst_estimate(PCB* process) {
+    if (process->current_burst <= 0) return;
 
-        if (size < shortest_size) {
-            shortest_size = size;
-            shortest_idx = i;
-        }
-    }
+    process->burst_estimate = BURST_ALPHA * process->current_burst +
+                              (1.0f - BURST_ALPHA) * process->burst_estimate;
+}
 
-    PCB* selected = pm->ready_queue[shortest_idx];
-    char* selected_binary = lookup_pid_in_tlb(selected->pid);
+PCB* sjf_select_next(ProcessManager* pm) {
+    if (!pm || pm->ready_count == 0) return NULL;
 
-    // Remove da fila
-    for (int i = shortest_idx; i < pm->ready_count - 1; i++) {
-        pm->ready_queue[i] = pm->ready_queue[i + 1];
-    }
-    pm->ready_count--;
+    // A fila de prontos é mantida como heap: a raiz é o menor restante
+    PCB* selected = ready_heap_pop(pm, sjf_less);
 
     // Resetar quantum ao selecionar
     selected->quantum_remaining = pm->quantum_size;
     selected->state = RUNNING;  // Atualiza estado para RUNNING
 
-    printf("\n[SJF] Selecionado processo PID(bin):%s (tamanho: %d bytes, quantum: %d)\n",
-           selected_binary ? selected_binary : "N/A",
-           shortest_size, selected->quantum_remaining);
+    printf("\n[SJF] Selecionado processo P%d (restante estimado: %d instruções, quantum: %d)\n",
+           selected->pid, sjf_remaining_estimate(selected), selected->quantum_remaining);
 
     return selected;
 }
 
+void sjf_on_process_ready(ProcessManager* pm, PCB* process) {
+    if (!pm || !process) return;
+    ready_heap_push(pm, process, sjf_less);
+}
+
 void sjf_on_quantum_expired(ProcessManager* pm, PCB* process) {
     if (!pm || !process) return;
 
-    char* binary_pid = lookup_pid_in_tlb(process->pid);
-    printf("\n[SJF] Quantum expirado para processo PID(bin):%s", binary_pid);
+    printf("\n[SJF] Quantum expirado para processo P%d", process->pid);
+
+    sjf_update_burst_estimate(process);
 
     // Garantir que o processo volta para a fila de prontos
     process->quantum_remaining = pm->quantum_size;
     process->state = READY;
+    ready_heap_push(pm, process, sjf_less);
 
-    // Verificar se já não está na fila antes de adicionar
-    int already_in_queue = 0;
-    for (int i = 0; i < pm->ready_count; i++) {
-        if (pm->ready_queue[i] == process) {
-            already_in_queue = 1;
-            break;
-        }
-    }
-
-    if (!already_in_queue) {
-        pm->ready_queue[pm->ready_count++] = process;
-        printf("\n[SJF] Processo PID(bin):%s retornado para fila de prontos", binary_pid);
-    }
+    printf("\n[SJF] Processo P%d retornado para fila de prontos (restante estimado: %d)",
+           process->pid, sjf_remaining_estimate(process));
 }
 
 void sjf_on_process_complete(ProcessManager* pm, PCB* process) {
     if (!pm || !process) return;
 
-    char* binary_pid = lookup_pid_in_tlb(process->pid);
-    printf("\n[SJF] Processo PID(bin):%s completado",
-           binary_pid ? binary_pid : "N/A");
+    printf("\n[SJF] Processo P%d completado", process->pid);
 
     process->state = FINISHED;
     process->was_completed = true;
-    process->completion_time = process->cycles_executed;
+    process->cold->completion_time = process->cycles_executed;
+}
+
+// SRTF: preempta quando a raiz da heap tem restante estritamente menor
+bool srtf_should_preempt(ProcessManager* pm, PCB* running) {
+    if (!pm || pm->ready_count == 0 || !running) return false;
+
+    PCB* candidate = pm->ready_queue[0];
+    if (sjf_remaining_estimate(candidate) >= sjf_remaining_estimate(running)) {
+        return false;
+    }
+
+    printf("\n[SRTF] P%d (restante: %d) preempta P%d (restante: %d)",
+           candidate->pid, sjf_remaining_estimate(candidate),
+           running->pid, sjf_remaining_estimate(running));
+    return true;
 }
 
 Policy* create_sjf_policy(void) {
@@ -107,6 +111,20 @@ Policy* create_sjf_policy(void) {
     policy->select_next = sjf_select_next;
     policy->on_quantum_expired = sjf_on_quantum_expired;
     policy->on_process_complete = sjf_on_process_complete;
+    policy->on_process_ready = sjf_on_process_ready;
+    policy->should_preempt = NULL;
     
+    return policy;
+}
+
+Policy* create_srtf_policy(void) {
+    Policy* policy = create_sjf_policy();
+    if (!policy) return NULL;
+
+    policy->type = POLICY_SRTF;
+    policy->name = "Shortest Remaining Time First";
+    policy->is_preemptive = true;
+    policy->should_preempt = srtf_should_preempt;
+
     return policy;
 }
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include "prefetcher.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static stride_entry stride_tables[NUM_CORES][STRIDE_TABLE_ENTRIES];
+static stream_entry streams[NUM_CORES][STREAM_BUFFERS];
+
+// Relógio por core: um tique por acesso de demanda (uma instrução por ciclo)
+static unsigned long core_clock[NUM_CORES];
+// Uso da primeira linha trazida pelo next-line dispara o próximo (prefetch marcado)
+static bool next_line_tagged[NUM_CORES];
+
+static prefetch_stats stats[PF_SOURCES];
+static int demand_misses = 0;
+
+static const char* source_names[PF_SOURCES] = { "Next-line", "Stride", "Stream" };
+
+void reset_prefetchers(void) {
+    memset(stride_tables, 0, sizeof(stride_tables));
+    memset(streams, 0, sizeof(streams));
+    memset(core_clock, 0, sizeof(core_clock));
+    memset(next_line_tagged, 0, sizeof(next_line_tagged));
+    memset(stats, 0, sizeof(stats));
+    demand_misses = 0;
+}
+
+unsigned long prefetcher_now(int core_id) {
+    return core_clock[core_id];
+}
+
+static bool enabled(PrefetchSource source) {
+    return (PREFETCHERS & PF_BIT(source)) != 0;
+}
+
+// Pede PREFETCH_DEGREE blocos a partir de PREFETCH_DISTANCE passos à frente
+static void issue(int core_id, unsigned int address, int step, PrefetchSource source) {
+    for (int i = 0; i < PREFETCH_DEGREE; i++) {
+        long target = (long)address + (long)step * (PREFETCH_DISTANCE + i);
+        if (target < 0) break;
+        if (prefetch_line(core_id, (unsigned int)target, source)) {
+            stats[source].issued++;
+        }
+    }
+}
+
+// ── Stride por PC ──
+
+static void train_stride(int core_id, unsigned int pc, unsigned int address) {
+    stride_entry* entry = &stride_tables[core_id][pc % STRIDE_TABLE_ENTRIES];
+    if (!entry->valid || entry->pc != pc) {
+        entry->pc = pc;
+        entry->last_address = address;
+        entry->stride = 0;
+        entry->confidence = 0;
+        entry->valid = true;
+        return;
+    }
+
+    int stride = (int)address - (int)entry->last_address;
+    entry->last_address = address;
+    if (stride == 0) return;
+
+    if (stride == entry->stride) {
+        if (entry->confidence < STRIDE_CONFIDENCE_MAX) entry->confidence++;
+    } else if (entry->confidence > 0) {
+        entry->confidence--;
+    } else {
+        entry->stride = stride;
+    }
+
+    if (entry->confidence >= STRIDE_CONFIDENCE_THRESHOLD) {
+        // Passo menor que o bloco avança bloco a bloco
+        int step = abs(entry->stride) < BLOCK_SIZE ?
+                   (entry->stride > 0 ? BLOCK_SIZE : -BLOCK_SIZE) : entry->stride;
+        issue(core_id, address, step, PF_STRIDE);
+    }
+}
+
+// ── Stream ──
+
+static stream_entry* stream_match(stream_entry* set, unsigned int block) {
+    for (int i = 0; i < STREAM_BUFFERS; i++) {
+        stream_entry* stream = &set[i];
+        if (!stream->valid) continue;
+
+        long ahead = (long)block - (long)stream->last_block;
+        if (stream->direction == 0) {
+            // Segundo miss adjacente confirma a direção
+            if (ahead == 1 || ahead == -1) {
+                stream->direction = (int)ahead;
+                return stream;
+            }
+        } else {
+            ahead *= stream->direction;
+            if (ahead >= 1 && ahead <= PREFETCH_DISTANCE + PREFETCH_DEGREE) return stream;
+        }
+    }
+    return NULL;
+}
+
+static void train_stream(int core_id, unsigned int address, bool hit) {
+    stream_entry* set = streams[core_id];
+    unsigned int block = address / BLOCK_SIZE;
+
+    stream_entry* stream = stream_match(set, block);
+    if (stream) {
+        stream->last_block = block;
+        stream->stamp = core_clock[core_id];
+        issue(core_id, address, stream->direction * BLOCK_SIZE, PF_STREAM);
+        return;
+    }
+    if (hit) return;
+
+    // Miss fora dos fluxos: ocupa o menos recente
+    stream_entry* victim = &set[0];
+    for (int i = 0; i < STREAM_BUFFERS; i++) {
+        if (!set[i].valid) {
+            victim = &set[i];
+            break;
+        }
+        if (set[i].stamp < victim->stamp) victim = &set[i];
+    }
+    victim->last_block = block;
+    victim->direction = 0;
+    victim->stamp = core_clock[core_id];
+    victim->valid = true;
+}
+
+// Acesso de demanda já resolvido na L1; `pc` é o endereço da instrução.
+// Só acessos de dados treinam o stride (a busca repete o próprio PC).
+void prefetcher_observe(int core_id, unsigned int pc, unsigned int address,
+                        bool hit, bool is_data) {
+    core_clock[core_id]++;
+    if (!hit) demand_misses++;
+
+    if (enabled(PF_STRIDE) && is_data) train_stride(core_id, pc, address);
+    if (enabled(PF_STREAM)) train_stream(core_id, address, hit);
+    if (enabled(PF_NEXT_LINE) && (!hit || next_line_tagged[core_id])) {
+        issue(core_id, address - CACHE_OFFSET(address), BLOCK_SIZE, PF_NEXT_LINE);
+    }
+    next_line_tagged[core_id] = false;
+}
+
+// Primeiro uso de demanda de uma linha prefetched; `ready` é quando o bloco chega
+void prefetcher_record_use(int core_id, PrefetchSource source, unsigned long ready) {
+    stats[source].useful++;
+    if (core_clock[core_id] < ready) {
+        stats[source].late++;
+        stats[source].late_cycles += ready - core_clock[core_id];
+    }
+    if (source == PF_NEXT_LINE) next_line_tagged[core_id] = true;
+}
+
+void print_prefetch_statistics(void) {
+    printf("\n\n╔═══════════ Prefetchers ═══════════╗");
+    printf("\n║ Grau %d, distância %d, misses de demanda: %d",
+           PREFETCH_DEGREE, PREFETCH_DISTANCE, demand_misses);
+    for (int source = 0; source < PF_SOURCES; source++) {
+        if (!enabled(source)) continue;
+        prefetch_stats* s = &stats[source];
+        printf("\n║ %s", source_names[source]);
+        printf("\n║ ├── Emitidos: %d, úteis: %d", s->issued, s->useful);
+        printf("\n║ ├── Precisão: %.1f%%",
+               s->issued > 0 ? (float)s->useful * 100 / s->issued : 0.0f);
+        printf("\n║ ├── Cobertura: %.1f%%",
+               s->useful + demand_misses > 0 ?
+               (float)s->useful * 100 / (s->useful + demand_misses) : 0.0f);
+        printf("\n║ └── Pontualidade: %.1f%% no prazo (%d atrasados, %ld ciclos de espera)",
+               s->useful > 0 ? (float)(s->useful - s->late) * 100 / s->useful : 0.0f,
+               s->late, s->late_cycles);
+    }
+    printf("\n╚═══════════════════════════════════╝\n");
+}
@@ -0,0 +1,72 @@
+#ifndef PREFETCHER_H
+#define PREFETCHER_H
+
+#include "cache.h"
+
+// Prefetchers de hardware da L1, treinados pelos endereços dos acessos
+// (busca de instrução e STOREs). Cada um pode ser ligado em PREFETCHERS:
+// - next-line: no miss, traz os blocos seguintes
+// - stride por PC: tabela indexada pelo endereço da instrução de dados
+// - stream: fluxos sequenciais (subindo ou descendo) confirmados por dois misses
+typedef enum {
+    PF_NEXT_LINE,
+    PF_STRIDE,
+    PF_STREAM,
+    PF_SOURCES
+} PrefetchSource;
+
+#define PF_BIT(source) (1u << (source))
+
+#ifndef PREFETCHERS
+#define PREFETCHERS (PF_BIT(PF_NEXT_LINE) | PF_BIT(PF_STRIDE) | PF_BIT(PF_STREAM))
+#endif
+
+// Grau: blocos pedidos por disparo; distância: quantos blocos à frente começa
+#ifndef PREFETCH_DEGREE
+#define PREFETCH_DEGREE 2
+#endif
+#ifndef PREFETCH_DISTANCE
+#define PREFETCH_DISTANCE 1
+#endif
+
+#ifndef STRIDE_TABLE_ENTRIES
+#define STRIDE_TABLE_ENTRIES 16
+#endif
+#define STRIDE_CONFIDENCE_MAX 3
+#define STRIDE_CONFIDENCE_THRESHOLD 2
+
+#ifndef STREAM_BUFFERS
+#define STREAM_BUFFERS 4
+#endif
+
+typedef struct {
+    unsigned int pc;
+    unsigned int last_address;
+    int stride;
+    int confidence;    // Saturante em 0..STRIDE_CONFIDENCE_MAX
+    bool valid;
+} stride_entry;
+
+typedef struct {
+    unsigned int last_block;  // Último bloco de demanda do fluxo
+    int direction;            // +1 ou -1 (0 enquanto não confirmado)
+    unsigned long stamp;      // Substituição do fluxo menos recente
+    bool valid;
+} stream_entry;
+
+// Métricas por prefetcher
+typedef struct {
+    int issued;
+    int useful;        // Linhas prefetched usadas por demanda
+    int late;          // Usadas antes de o bloco chegar
+    long late_cycles;  // Espera que sobrou nas usadas atrasadas
+} prefetch_stats;
+
+void reset_prefetchers(void);
+void prefetcher_observe(int core_id, unsigned int pc, unsigned int address,
+                        bool hit, bool is_data);
+unsigned long prefetcher_now(int core_id);
+void prefetcher_record_use(int core_id, PrefetchSource source, unsigned long ready);
+void print_prefetch_statistics(void);
+
+#endif
@@ -1,5 +1,6 @@
 #include "ram.h"
 #include "cpu.h" 
+#include "instruction_utils.h"
 
 ram* allocate_ram(size_t memory_size) {
     ram* memory_ram = malloc(sizeof(ram));
@@ -22,10 +23,129 @@ ram* allocate_ram(size_t memory_size) {
     memory_ram->size = memory_size;
     memory_ram->initialized = true;
     pthread_mutex_init(&memory_ram->mutex, NULL);
+
+    // Toda a RAM começa como um único bloco livre
+    memory_ram->free_blocks = malloc(sizeof(ram_block));
+    if (memory_ram->free_blocks) {
+        memory_ram->free_blocks->base = 0;
+        memory_ram->free_blocks->size = memory_size;
+        memory_ram->free_blocks->next = NULL;
+    }
     
     return memory_ram;
 }
 
+// First-fit: retorna o endereço base do bloco ou -1 se não houver espaço
+int ram_alloc(ram* memory_ram, unsigned int size) {
+    if (!memory_ram || size == 0) return -1;
+
+    ram_block** link = &memory_ram->free_blocks;
+    while (*link) {
+        ram_block* block = *link;
+        if (block->size >= size) {
+            int base = block->base;
+            block->base += size;
+            block->size -= size;
+            if (block->size == 0) {
+                *link = block->next;
+                free(block);
+            }
+            return base;
+        }
+        link = &block->next;
+    }
+    return -1;
+}
+
+// First-fit com a base múltipla de `align` (frames de página); a sobra
+// antes da base continua livre
+int ram_alloc_aligned(ram* memory_ram, unsigned int size, unsigned int align) {
+    if (!memory_ram || size == 0 || align == 0) return -1;
+
+    ram_block** link = &memory_ram->free_blocks;
+    while (*link) {
+        ram_block* block = *link;
+        unsigned int base = (block->base + align - 1) / align * align;
+        unsigned int end = block->base + block->size;
+        if (base + size > end) {
+            link = &block->next;
+            continue;
+        }
+
+        // Bloco dividido em [block->base, base) e [base + size, end)
+        if (base + size < end) {
+            ram_block* rest = malloc(sizeof(ram_block));
+            if (!rest) return -1;
+            rest->base = base + size;
+            rest->size = end - rest->base;
+            rest->next = block->next;
+            block->next = rest;
+        }
+        block->size = base - block->base;
+        if (block->size == 0) {
+            *link = block->next;
+            free(block);
+        }
+        return base;
+    }
+    return -1;
+}
+
+// Devolve o bloco à lista, fundindo com os vizinhos livres
+void ram_free(ram* memory_ram, unsigned int base, unsigned int size) {
+    if (!memory_ram || size == 0) return;
+
+    ram_block* prev = NULL;
+    ram_block* next = memory_ram->free_blocks;
+    while (next && next->base < base) {
+        prev = next;
+        next = next->next;
+    }
+
+    if (prev && prev->base + prev->size == base) {
+        prev->size += size;
+        if (next && prev->base + prev->size == next->base) {
+            prev->size += next->size;
+            prev->next = next->next;
+            free(next);
+        }
+        return;
+    }
+
+    if (next && base + size == next->base) {
+        next->base = base;
+        next->size += size;
+        return;
+    }
+
+    ram_block* block = malloc(sizeof(ram_block));
+    if (!block) return;
+    block->base = base;
+    block->size = size;
+    block->next = next;
+    if (prev) prev->next = block; else memory_ram->free_blocks = block;
+}
+
+// Faixa inteira dentro de um bloco livre (fora das regiões dos programas)
+bool ram_range_free(ram* memory_ram, unsigned int base, unsigned int size) {
+    if (!memory_ram) return false;
+
+    for (ram_block* block = memory_ram->free_blocks; block; block = block->next) {
+        if (base >= block->base && base + size <= block->base + block->size) return true;
+    }
+    return false;
+}
+
+void free_ram_blocks(ram* memory_ram) {
+    if (!memory_ram) return;
+
+    while (memory_ram->free_blocks) {
+        ram_block* next = memory_ram->free_blocks->next;
+        free(memory_ram->free_blocks);
+        memory_ram->free_blocks = next;
+    }
+}
+
 bool verify_ram(ram* memory_ram, const char* context) {
     if (!memory_ram) {
         printf("\n[Verify RAM] RAM nula em %s", context);
@@ -64,7 +184,7 @@ void write_ram(ram* memory_ram, unsigned short int address, const char* data) {
     //printf("\n[RAM] Escrevendo '%s' no endereço %d", data, address);
 
     // Copiar os dados para a RAM
-    strncpy(memory_ram->vector + address, data, data_length);
+    memcpy(memory_ram->vector + address, data, data_length);
 
     // Garantir terminador nulo se houver espaço
     if (address + data_length < NUM_MEMORY) {
@@ -90,7 +210,9 @@ void load_program_on_ram(struct cpu* cpu, char* program_content, unsigned int ba
 
     size_t program_length = strlen(program_content);
 
-    pcb->program_size = program_length;
+    pcb->cold->program_size = program_length;
+    pcb->estimated_instructions = estimate_program_instructions(program_content);
+    compute_instruction_signature(program_content, &pcb->cold->signature);
 
     // Verifica se há espaço suficiente na memória
     if (base_address + program_length >= NUM_MEMORY) {
@@ -103,7 +225,7 @@ void load_program_on_ram(struct cpu* cpu, char* program_content, unsigned int ba
     memset(dest_addr, 0, program_length + 1);
 
     // Copia o programa
-    strncpy(dest_addr, program_content, program_length);
+    memcpy(dest_addr, program_content, program_length);
     dest_addr[program_length] = '\0';
 
     pthread_mutex_unlock(&cpu->memory_ram->mutex);
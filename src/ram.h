@@ -6,11 +6,19 @@
 #include "libs.h"
 #include "pcb.h"
 
+// Bloco livre da RAM (lista ordenada por endereço)
+typedef struct ram_block {
+    unsigned int base;
+    unsigned int size;
+    struct ram_block* next;
+} ram_block;
+
 typedef struct ram {
     char *vector;
     size_t size;
     pthread_mutex_t mutex;
     bool initialized;
+    ram_block* free_blocks;  // Espaço livre para programas
 } ram;
 
 struct cpu;
@@ -21,4 +29,11 @@ void load_program_on_ram(struct cpu* cpu, char* program_content, unsigned int ba
 void write_ram(ram* memory_ram, unsigned short int address, const char* data);
 bool verify_ram(ram* memory_ram, const char* context);
 
+// Alocação dinâmica de memória por processo (chamador segura o mutex)
+int ram_alloc(ram* memory_ram, unsigned int size);
+int ram_alloc_aligned(ram* memory_ram, unsigned int size, unsigned int align);
+void ram_free(ram* memory_ram, unsigned int base, unsigned int size);
+void free_ram_blocks(ram* memory_ram);
+bool ram_range_free(ram* memory_ram, unsigned int base, unsigned int size);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,28 @@
+#include "sim_random.h"
+
+void sim_rng_seed(sim_rng* rng, uint64_t seed) {
+    // Estado zero é ponto fixo do xorshift
+    rng->state = seed ? seed : 0x9E3779B97F4A7C15ULL;
+}
+
+uint32_t sim_rng_next(sim_rng* rng) {
+    uint64_t x = rng->state;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    rng->state = x;
+    return (uint32_t)((x * 0x2545F4914F6CDD1DULL) >> 32);
+}
+
+// Valor uniforme em [0, bound) sem viés de módulo
+uint32_t sim_rng_range(sim_rng* rng, uint32_t bound) {
+    if (bound == 0) return 0;
+
+    uint32_t threshold = -bound % bound;
+    uint32_t value;
+    do {
+        value = sim_rng_next(rng);
+    } while (value < threshold);
+
+    return value % bound;
+}
@@ -0,0 +1,20 @@
+#ifndef SIM_RANDOM_H
+#define SIM_RANDOM_H
+
+#include <stdint.h>
+
+#ifndef DEFAULT_SEED
+#define DEFAULT_SEED 42
+#endif
+
+// Gerador xorshift64* com estado explícito: execuções com a mesma semente
+// produzem os mesmos sorteios, independente de rand()/srand().
+typedef struct sim_rng {
+    uint64_t state;
+} sim_rng;
+
+void sim_rng_seed(sim_rng* rng, uint64_t seed);
+uint32_t sim_rng_next(sim_rng* rng);
+uint32_t sim_rng_range(sim_rng* rng, uint32_t bound);
+
+#endif
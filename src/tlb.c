@@ -1,86 +1,125 @@
 #include "tlb.h"
+#include "cpu.h"
+#include <string.h>
 
-TLBEntry tlb[TLB_SIZE];
+static tlb_entry tlb[NUM_CORES][TLB_SIZE];
+static unsigned long tlb_clock = 0;
 
+static int tlb_hits[NUM_CORES];
+static int tlb_misses[NUM_CORES];
+static long walk_cycles[NUM_CORES];
+static int shootdowns = 0;           // Eventos de shootdown (um IPI por core remoto)
+static int shootdown_entries = 0;    // Entradas derrubadas por eles
+static long shootdown_cycles = 0;
 
-// Converte PID para binário
-char* convert_pid_to_binary(int pid) {
-    char* binary = (char*)malloc(33); // 32 bits + terminador nulo
-    binary[32] = '\0';
+void reset_tlb(void) {
+    memset(tlb, 0, sizeof(tlb));
+    tlb_clock = 0;
+    memset(tlb_hits, 0, sizeof(tlb_hits));
+    memset(tlb_misses, 0, sizeof(tlb_misses));
+    memset(walk_cycles, 0, sizeof(walk_cycles));
+    shootdowns = shootdown_entries = 0;
+    shootdown_cycles = 0;
+}
+
+static tlb_entry* tlb_set(int core_id, unsigned int page) {
+    return &tlb[core_id][(page % TLB_SETS) * TLB_WAYS];
+}
 
-    // Inicializa string com zeros
-    for(int i = 0; i < 32; i++) {
-        binary[i] = '0';
+bool tlb_lookup(int core_id, int asid, unsigned int page, uint16_t* frame) {
+    tlb_entry* set = tlb_set(core_id, page);
+    for (int way = 0; way < TLB_WAYS; way++) {
+        if (set[way].valid && set[way].asid == asid && set[way].page == page) {
+            set[way].last_used = ++tlb_clock;
+            tlb_hits[core_id]++;
+            if (frame) *frame = set[way].frame;
+            return true;
+        }
     }
+    tlb_misses[core_id]++;
+    return false;
+}
 
-    // Converte para binário
-    int i = 31;
-    while(pid > 0 && i >= 0) {
-        binary[i] = (pid % 2) + '0';
-        pid = pid / 2;
-        i--;
+// Depois do page walk: ocupa uma via livre ou a menos usada do conjunto
+void tlb_insert(int core_id, int asid, unsigned int page, uint16_t frame) {
+    tlb_entry* set = tlb_set(core_id, page);
+    tlb_entry* victim = &set[0];
+    for (int way = 0; way < TLB_WAYS; way++) {
+        if (!set[way].valid) {
+            victim = &set[way];
+            break;
+        }
+        if (set[way].last_used < victim->last_used) victim = &set[way];
     }
 
-    return binary;
+    victim->asid = asid;
+    victim->page = page;
+    victim->frame = frame;
+    victim->last_used = ++tlb_clock;
+    victim->valid = true;
 }
 
-// Função de hash
-int hash_pid(int pid) {
-    return pid % TLB_SIZE;
+void tlb_note_walk(int core_id, int cycles) {
+    walk_cycles[core_id] += cycles;
 }
 
-// Inicializa a TLB
-void init_process_tlb() {
-    for(int i = 0; i < TLB_SIZE; i++) {
-        tlb[i].pid = -1;
-        tlb[i].binary_pid = NULL;
-        tlb[i].valid = 0;
+// Remove as entradas que casam em todos os cores; cada core remoto com
+// cópia recebe uma interrupção. Devolve os ciclos gastos.
+static int shootdown(int asid, unsigned int page, bool whole_asid) {
+    int cycles = 0;
+    for (int core = 0; core < NUM_CORES; core++) {
+        bool hit = false;
+        for (int i = 0; i < TLB_SIZE; i++) {
+            tlb_entry* entry = &tlb[core][i];
+            if (entry->valid && entry->asid == asid && (whole_asid || entry->page == page)) {
+                entry->valid = false;
+                shootdown_entries++;
+                hit = true;
+            }
+        }
+        if (hit) cycles += TLB_SHOOTDOWN_LATENCY;
     }
+    if (cycles > 0) shootdowns++;
+    shootdown_cycles += cycles;
+    return cycles;
 }
 
-// Insere PID na TLB
-void insert_pid_in_tlb(int pid) {
-    int index = hash_pid(pid);
-
-    // Libera entrada anterior se existir
-    if(tlb[index].binary_pid != NULL) {
-        free(tlb[index].binary_pid);
-    }
-
-    // Insere nova entrada
-    tlb[index].pid = pid;
-    tlb[index].binary_pid = convert_pid_to_binary(pid);
-    tlb[index].valid = 1;
+// Página desmapeada (tabela já atualizada)
+int tlb_shootdown(int asid, unsigned int page) {
+    return shootdown(asid, page, false);
 }
 
-// Busca PID na TLB
-char* lookup_pid_in_tlb(int pid) {
-    int index = hash_pid(pid);
-
-    if(tlb[index].valid && tlb[index].pid == pid) {
-        return tlb[index].binary_pid;
-    }
-    return NULL;
+// Espaço de endereçamento inteiro liberado (fim do processo)
+int tlb_flush_asid(int asid) {
+    return shootdown(asid, 0, true);
 }
 
-// Libera a TLB
-void free_process_tlb() {
-    for(int i = 0; i < TLB_SIZE; i++) {
-        if(tlb[i].binary_pid != NULL) {
-            free(tlb[i].binary_pid);
-            tlb[i].binary_pid = NULL;
-        }
+void print_tlb_statistics(void) {
+    int hits = 0, misses = 0;
+    long cycles = 0;
+    for (int core = 0; core < NUM_CORES; core++) {
+        hits += tlb_hits[core];
+        misses += tlb_misses[core];
+        cycles += walk_cycles[core];
     }
-}
 
-// Imprime conteúdo da TLB
-void print_tlb_contents() {
-    printf("\n=== TLB Contents ===\n");
-    for(int i = 0; i < TLB_SIZE; i++) {
-        if(tlb[i].valid) {
-            printf("Index %d: PID %d -> Binary: %s\n",
-                   i, tlb[i].pid, tlb[i].binary_pid);
-        }
+    printf("\n\n╔═══════════ TLB ═══════════╗");
+    if (TLB_WAYS == TLB_SIZE) {
+        printf("\n║ %d entradas por core, totalmente associativa (LRU)", TLB_SIZE);
+    } else {
+        printf("\n║ %d entradas por core, %d conjuntos x %d vias (LRU)",
+               TLB_SIZE, TLB_SETS, TLB_WAYS);
+    }
+    printf("\n║ Consultas: %d, hits: %d, misses: %d", hits + misses, hits, misses);
+    printf("\n║ Hit rate: %.1f%%", hits + misses > 0 ? (float)hits * 100 / (hits + misses) : 0.0f);
+    for (int core = 0; core < NUM_CORES; core++) {
+        int lookups = tlb_hits[core] + tlb_misses[core];
+        if (lookups == 0) continue;
+        printf("\n║ ├── Core %d: %.1f%% de %d consultas", core,
+               (float)tlb_hits[core] * 100 / lookups, lookups);
     }
-    printf("==================\n");
+    printf("\n║ Ciclos de page walk: %ld (%d por miss)", cycles, PAGE_WALK_LATENCY);
+    printf("\n║ Shootdowns: %d (%d entradas, %ld ciclos)",
+           shootdowns, shootdown_entries, shootdown_cycles);
+    printf("\n╚═══════════════════════════╝\n");
 }
@@ -1,26 +1,45 @@
+#ifndef TLB_H
+#define TLB_H
+
 #include <stdio.h>
-#include <stdlib.h>
-#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
 
-// Tamanho da TLB
+// TLB de dados por core: guarda traduções (ASID, página virtual) → frame.
+// O ASID é o PID, então trocar de processo não esvazia a TLB; desmapear
+// uma página derruba as cópias em todos os cores (shootdown).
+// TLB_WAYS == TLB_SIZE é totalmente associativa; menos vias, set-associativa.
+#ifndef TLB_SIZE
 #define TLB_SIZE 16
+#endif
+#ifndef TLB_WAYS
+#define TLB_WAYS TLB_SIZE
+#endif
+#define TLB_SETS (TLB_SIZE / TLB_WAYS)
 
-// Estrutura para entrada da TLB
-typedef struct {
-    int pid;              // ID original do processo
-    char* binary_pid;     // ID em formato binário
-    int valid;            // Flag de entrada válida
-} TLBEntry;
-
+#if TLB_SIZE % TLB_WAYS != 0
+#error "TLB_SIZE deve ser múltiplo de TLB_WAYS"
+#endif
 
-void insert_pid_in_tlb(int pid);
-char* lookup_pid_in_tlb(int pid);
-void init_process_tlb();
-void free_process_tlb();
-void print_tlb_contents();
+#ifndef PAGE_WALK_LATENCY
+#define PAGE_WALK_LATENCY 8        // Miss: leitura da entrada na tabela de páginas
+#endif
+#define TLB_SHOOTDOWN_LATENCY 2    // Interrupção entre cores por shootdown
 
+typedef struct {
+    int asid;
+    unsigned int page;
+    uint16_t frame;
+    unsigned long last_used;   // LRU dentro do conjunto
+    bool valid;
+} tlb_entry;
 
-#ifndef TLB_H
-#define TLB_H
+void reset_tlb(void);
+bool tlb_lookup(int core_id, int asid, unsigned int page, uint16_t* frame);
+void tlb_insert(int core_id, int asid, unsigned int page, uint16_t frame);
+void tlb_note_walk(int core_id, int cycles);
+int tlb_shootdown(int asid, unsigned int page);
+int tlb_flush_asid(int asid);
+void print_tlb_statistics(void);
 
-#endif //TLB_H
+#endif
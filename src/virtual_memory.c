@@ -0,0 +1,333 @@
+#include "virtual_memory.h"
+#include "cache.h"
+#include "tlb.h"
+#include <stdio.h>
+#include <string.h>
+
+static frame_entry frames[NUM_FRAMES];
+static disc* swap_disc = NULL;
+
+// Relógio de traduções e ponteiro do Clock/WSClock sobre os frames
+static unsigned long access_clock = 0;
+static int clock_hand = 0;
+
+static int page_faults = 0;
+static int major_faults = 0;    // Página veio do swap
+static int failed_faults = 0;   // Sem frame livre nem vítima: o acesso é descartado
+static int translations = 0;
+static int frames_in_use = 0;
+static int peak_frames = 0;
+static int address_spaces = 0;
+static long fault_cycles = 0;
+
+static int swap_ins = 0;
+static int swap_outs = 0;        // Vítimas expulsas da RAM
+static int swap_writes = 0;      // Expulsas sujas (ou sem cópia) gravadas no disco
+static int wsclock_cleanings = 0; // Sujas gravadas pelo WSClock sem expulsar
+
+// Taxa de faltas por janela de THRASHING_WINDOW traduções
+static int window_translations = 0;
+static int window_faults = 0;
+static int windows = 0;
+static int thrashing_windows = 0;
+static float peak_fault_rate = 0.0f;
+
+static const char* replacement_names[] = {"Clock", "LRU", "WSClock"};
+
+void reset_virtual_memory(void) {
+    memset(frames, 0, sizeof(frames));
+    access_clock = 0;
+    clock_hand = 0;
+    page_faults = major_faults = failed_faults = translations = 0;
+    frames_in_use = peak_frames = address_spaces = 0;
+    fault_cycles = 0;
+    swap_ins = swap_outs = swap_writes = wsclock_cleanings = 0;
+    window_translations = window_faults = windows = thrashing_windows = 0;
+    peak_fault_rate = 0.0f;
+}
+
+void attach_swap_disc(disc* memory_disc) {
+    swap_disc = memory_disc;
+}
+
+// Tabela vazia: nenhuma página presente até o primeiro acesso
+bool create_address_space(PCB* process) {
+    if (!process) return false;
+
+    process->page_table = calloc(VIRTUAL_PAGES, sizeof(page_table_entry));
+    if (!process->page_table) return false;
+    address_spaces++;
+    return true;
+}
+
+// Frame volta ao alocador da RAM; cópias na cache são descartadas para um
+// writeback tardio não sobrescrever o próximo dono
+static void release_frame(ram* memory_ram, int frame) {
+    cache_invalidate_range(frame * PAGE_SIZE, PAGE_SIZE);
+    ram_free(memory_ram, frame * PAGE_SIZE, PAGE_SIZE);
+    frames[frame].owner = NULL;
+    frames[frame].mapped = false;
+    frames_in_use--;
+}
+
+// Fim do processo: devolve os frames, os slots de swap e a tabela
+// (chamador segura o mutex da RAM)
+void release_address_space(ram* memory_ram, PCB* process) {
+    if (!process || !process->page_table) return;
+
+    tlb_flush_asid(process->pid);
+
+    for (int page = 0; page < VIRTUAL_PAGES; page++) {
+        page_table_entry* entry = &process->page_table[page];
+        if (entry->flags & PTE_PRESENT) release_frame(memory_ram, entry->frame);
+        if (entry->flags & PTE_SWAPPED) disc_free_slot(swap_disc, entry->swap_slot);
+    }
+    free(process->page_table);
+    process->page_table = NULL;
+}
+
+// Bytes sujos nas L1 voltam à RAM antes de a página sair dela
+static void flush_frame_from_caches(int frame) {
+    for (unsigned int address = frame * PAGE_SIZE; address < (frame + 1u) * PAGE_SIZE;
+         address += BLOCK_SIZE) {
+        for (int core = 0; core < NUM_CORES; core++) {
+            cache_invalidate_block(core, address);
+        }
+    }
+}
+
+// Grava a página do frame no seu slot (alocado na primeira vez). Devolve
+// os ciclos de disco ou -1 com o swap cheio.
+static int write_to_swap(ram* memory_ram, int frame) {
+    page_table_entry* entry = &frames[frame].owner->page_table[frames[frame].page];
+    if (!(entry->flags & PTE_SWAPPED)) {
+        int slot = disc_alloc_slot(swap_disc);
+        if (slot < 0) return -1;
+        entry->swap_slot = slot;
+        entry->flags |= PTE_SWAPPED;
+    }
+
+    flush_frame_from_caches(frame);
+    entry->flags &= ~PTE_DIRTY;
+    return disc_write_slot(swap_disc, entry->swap_slot, memory_ram->vector + frame * PAGE_SIZE);
+}
+
+static bool frame_referenced(int frame) {
+    return frames[frame].owner->page_table[frames[frame].page].flags & PTE_REFERENCED;
+}
+
+static void clear_referenced(int frame) {
+    frames[frame].owner->page_table[frames[frame].page].flags &= ~PTE_REFERENCED;
+}
+
+static bool frame_dirty(int frame) {
+    return frames[frame].owner->page_table[frames[frame].page].flags & PTE_DIRTY;
+}
+
+static int select_victim_clock(void) {
+    // Duas voltas bastam: a primeira limpa os bits de referência
+    for (int step = 0; step < 2 * NUM_FRAMES; step++) {
+        int frame = clock_hand;
+        clock_hand = (clock_hand + 1) % NUM_FRAMES;
+        if (!frames[frame].mapped) continue;
+        if (!frame_referenced(frame)) return frame;
+        clear_referenced(frame);
+    }
+    return -1;
+}
+
+static int select_victim_lru(void) {
+    int victim = -1;
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        if (!frames[frame].mapped) continue;
+        if (victim < 0 || frames[frame].last_used < frames[victim].last_used) victim = frame;
+    }
+    return victim;
+}
+
+// WSClock: frames referenciados ganham idade zero; fora do working set, a
+// limpa é expulsa e a suja é gravada (volta limpa na próxima passagem).
+// Sem candidata em duas voltas, fica o frame mais antigo.
+static int select_victim_wsclock(ram* memory_ram, int* latency) {
+    int oldest = -1;
+    for (int step = 0; step < 2 * NUM_FRAMES; step++) {
+        int frame = clock_hand;
+        clock_hand = (clock_hand + 1) % NUM_FRAMES;
+        if (!frames[frame].mapped) continue;
+
+        if (frame_referenced(frame)) {
+            clear_referenced(frame);
+            frames[frame].last_used = access_clock;
+            continue;
+        }
+        if (oldest < 0 || frames[frame].last_used < frames[oldest].last_used) oldest = frame;
+        if (access_clock - frames[frame].last_used <= WORKING_SET_WINDOW) continue;
+
+        if (!frame_dirty(frame)) return frame;
+        int cycles = write_to_swap(memory_ram, frame);
+        if (cycles >= 0) {
+            *latency += cycles;
+            wsclock_cleanings++;
+        }
+    }
+    return oldest >= 0 ? oldest : select_victim_lru();
+}
+
+// Expulsa uma página de dados para o swap e devolve o frame livre para
+// reuso, ou -1 se não há vítima (chamador segura o mutex da RAM)
+static int evict_page(ram* memory_ram, int* latency) {
+    if (!swap_disc || frames_in_use == 0) return -1;
+
+    int frame;
+    switch (PAGE_REPLACEMENT) {
+        case PAGE_LRU: frame = select_victim_lru(); break;
+        case PAGE_WSCLOCK: frame = select_victim_wsclock(memory_ram, latency); break;
+        default: frame = select_victim_clock(); break;
+    }
+    if (frame < 0) return -1;
+
+    PCB* owner = frames[frame].owner;
+    unsigned int page = frames[frame].page;
+    page_table_entry* entry = &owner->page_table[page];
+
+    // Limpa, a página já está no swap ou nunca saiu dos zeros da falta
+    if (entry->flags & PTE_DIRTY) {
+        int cycles = write_to_swap(memory_ram, frame);
+        if (cycles < 0) return -1;
+        *latency += cycles;
+        swap_writes++;
+    } else {
+        flush_frame_from_caches(frame);
+    }
+
+    entry->flags &= ~(PTE_PRESENT | PTE_REFERENCED);
+    *latency += tlb_shootdown(owner->pid, page);
+    frames[frame].owner = NULL;
+    frames[frame].mapped = false;
+    frames_in_use--;
+    swap_outs++;
+    return frame;
+}
+
+// Falta de página: frame alinhado do alocador da RAM ou de uma vítima,
+// preenchido com zeros ou com a cópia do swap
+static bool handle_page_fault(ram* memory_ram, PCB* process, unsigned int page, int* latency) {
+    page_faults++;
+    window_faults++;
+
+    int frame = -1;
+    if (frames_in_use < DATA_FRAMES) {
+        int base = ram_alloc_aligned(memory_ram, PAGE_SIZE, PAGE_SIZE);
+        if (base >= 0) {
+            frame = base / PAGE_SIZE;
+            cache_invalidate_range(base, PAGE_SIZE);
+        }
+    }
+    if (frame < 0) frame = evict_page(memory_ram, latency);
+    if (frame < 0) {
+        failed_faults++;
+        return false;
+    }
+
+    page_table_entry* entry = &process->page_table[page];
+    char* data = memory_ram->vector + frame * PAGE_SIZE;
+    if (entry->flags & PTE_SWAPPED) {
+        *latency += disc_read_slot(swap_disc, entry->swap_slot, data);
+        major_faults++;
+        swap_ins++;
+    } else {
+        memset(data, 0, PAGE_SIZE);
+    }
+
+    frames[frame].owner = process;
+    frames[frame].page = page;
+    frames[frame].mapped = true;
+    frames[frame].last_used = access_clock;
+    if (++frames_in_use > peak_frames) peak_frames = frames_in_use;
+
+    entry->frame = frame;
+    entry->flags = (entry->flags & PTE_SWAPPED) | PTE_PRESENT;
+    return true;
+}
+
+static void track_fault_rate(void) {
+    if (++window_translations < THRASHING_WINDOW) return;
+
+    float rate = (float)window_faults / window_translations;
+    if (rate > peak_fault_rate) peak_fault_rate = rate;
+    if (rate > THRASHING_FAULT_RATE) thrashing_windows++;
+    windows++;
+    window_translations = window_faults = 0;
+}
+
+// Endereço virtual do processo para físico, ou -1 se a falta não puder ser
+// atendida. A TLB do core resolve o hit; no miss, page walk e, se a página
+// não está presente, falta. Soma em `latency` os ciclos de walk, falta e
+// disco (chamador segura o mutex da RAM).
+int translate_address(ram* memory_ram, PCB* process, int core_id, unsigned int address,
+                      bool write, int* latency) {
+    if (!memory_ram || !process || !process->page_table || address >= NUM_MEMORY) return -1;
+
+    translations++;
+    access_clock++;
+    unsigned int page = PAGE_NUMBER(address);
+    page_table_entry* entry = &process->page_table[page];
+    int cycles = 0;
+    uint16_t frame;
+    if (!tlb_lookup(core_id, process->pid, page, &frame)) {
+        tlb_note_walk(core_id, PAGE_WALK_LATENCY);
+        cycles += PAGE_WALK_LATENCY;
+
+        if (!(entry->flags & PTE_PRESENT)) {
+            int fault_latency = PAGE_FAULT_LATENCY;
+            bool mapped = handle_page_fault(memory_ram, process, page, &fault_latency);
+            fault_cycles += fault_latency;
+            cycles += fault_latency;
+            if (!mapped) {
+                if (latency) *latency += cycles;
+                track_fault_rate();
+                return -1;
+            }
+        }
+        frame = entry->frame;
+        tlb_insert(core_id, process->pid, page, frame);
+    }
+    track_fault_rate();
+
+    entry->flags |= PTE_REFERENCED;
+    if (write) entry->flags |= PTE_DIRTY;
+    frames[frame].last_used = access_clock;
+    if (latency) *latency += cycles;
+    return frame * PAGE_SIZE + PAGE_OFFSET(address);
+}
+
+void print_virtual_memory_statistics(void) {
+    printf("\n\n╔═══════════ Memória Virtual ═══════════╗");
+    printf("\n║ Páginas de %d bytes, %d páginas virtuais por processo",
+           PAGE_SIZE, VIRTUAL_PAGES);
+    printf("\n║ Espaços de endereçamento criados: %d", address_spaces);
+    printf("\n║ Traduções: %d", translations);
+    printf("\n║ Faltas de página: %d (do swap: %d, sem frame livre: %d)",
+           page_faults, major_faults, failed_faults);
+    printf("\n║ Ciclos em faltas de página: %ld", fault_cycles);
+    printf("\n║ Frames de dados: %d em uso, pico %d de %d",
+           frames_in_use, peak_frames, DATA_FRAMES);
+    if (swap_disc) {
+        printf("\n╠═══════════════════════════════════════╣");
+        printf("\n║ Swap: substituição %s, %d slots (%d livres)",
+               replacement_names[PAGE_REPLACEMENT], swap_disc->slots, swap_disc->free_slots);
+        printf("\n║ ├── Swap-out: %d (gravadas no disco: %d)", swap_outs, swap_writes);
+        if (PAGE_REPLACEMENT == PAGE_WSCLOCK) {
+            printf("\n║ ├── Limpezas do WSClock: %d", wsclock_cleanings);
+        }
+        printf("\n║ ├── Swap-in: %d", swap_ins);
+        printf("\n║ └── Disco: %d leituras, %d escritas, %ld ciclos",
+               swap_disc->reads, swap_disc->writes, swap_disc->busy_cycles);
+    }
+    if (windows > 0) {
+        printf("\n║ Thrashing: %d de %d janelas de %d traduções acima de %.0f%% de faltas",
+               thrashing_windows, windows, THRASHING_WINDOW, THRASHING_FAULT_RATE * 100);
+        printf("\n║ Pico da taxa de faltas: %.1f%%", peak_fault_rate * 100);
+    }
+    printf("\n╚═══════════════════════════════════════╝\n");
+}
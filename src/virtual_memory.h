@@ -0,0 +1,79 @@
+#ifndef VIRTUAL_MEMORY_H
+#define VIRTUAL_MEMORY_H
+
+#include "pcb.h"
+#include "ram.h"
+#include "cache.h"
+#include "disc.h"
+#include <stdint.h>
+
+// Memória virtual paginada para os dados dos processos: cada PCB tem a sua
+// tabela de páginas e os endereços de LOAD/STORE (A<n>) são virtuais. As
+// páginas ganham um frame da RAM no primeiro toque (falta de página). O
+// código continua numa região contígua (o interpretador varre o texto).
+// Sem frame livre, uma vítima vai para o swap no disco e volta na falta.
+#ifndef PAGE_SIZE
+#define PAGE_SIZE 32
+#endif
+#if PAGE_SIZE % BLOCK_SIZE != 0 || (PAGE_SIZE & (PAGE_SIZE - 1)) != 0
+#error "PAGE_SIZE deve ser potência de 2 e múltiplo de BLOCK_SIZE"
+#endif
+
+#define VIRTUAL_PAGES (NUM_MEMORY / PAGE_SIZE)  // Espaço de endereços por processo
+#define NUM_FRAMES (NUM_MEMORY / PAGE_SIZE)
+#define PAGE_NUMBER(address) ((address) / PAGE_SIZE)
+#define PAGE_OFFSET(address) ((address) % PAGE_SIZE)
+
+#ifndef PAGE_FAULT_LATENCY
+#define PAGE_FAULT_LATENCY 20      // Tratamento da falta, sem contar o disco
+#endif
+
+// Teto de frames de dados (abaixo de NUM_FRAMES força a troca de páginas)
+#ifndef DATA_FRAMES
+#define DATA_FRAMES NUM_FRAMES
+#endif
+
+typedef enum {
+    PAGE_CLOCK,    // Segunda chance pelo bit de referência
+    PAGE_LRU,      // Frame com o acesso mais antigo
+    PAGE_WSCLOCK   // Clock que poupa o working set e limpa sujas antes de expulsar
+} PageReplacement;
+
+#ifndef PAGE_REPLACEMENT
+#define PAGE_REPLACEMENT PAGE_CLOCK
+#endif
+#define WORKING_SET_WINDOW 64      // WSClock: idade (em traduções) fora do working set
+
+// Thrashing: janela de traduções com taxa de faltas acima do limiar
+#define THRASHING_WINDOW 50
+#define THRASHING_FAULT_RATE 0.3f
+
+// Flags da entrada da tabela de páginas
+#define PTE_PRESENT     0x01
+#define PTE_DIRTY       0x02
+#define PTE_REFERENCED  0x04
+#define PTE_SWAPPED     0x08       // Há cópia da página no slot de swap
+
+typedef struct page_table_entry {
+    uint16_t frame;
+    uint16_t swap_slot;   // Válido com PTE_SWAPPED
+    uint8_t flags;
+} page_table_entry;
+
+// Tabela invertida: dono de cada frame mapeado (frames de código ficam fora)
+typedef struct {
+    PCB* owner;
+    uint16_t page;
+    bool mapped;
+    unsigned long last_used;  // Relógio de traduções (LRU e WSClock)
+} frame_entry;
+
+void reset_virtual_memory(void);
+void attach_swap_disc(disc* memory_disc);
+bool create_address_space(PCB* process);
+void release_address_space(ram* memory_ram, PCB* process);
+int translate_address(ram* memory_ram, PCB* process, int core_id, unsigned int address,
+                      bool write, int* latency);
+void print_virtual_memory_statistics(void);
+
+#endif
@@ -0,0 +1,189 @@
+#include "workload.h"
+#include "reader.h"
+#include "instruction_utils.h"
+#include "ram.h"
+#include "os_display.h"
+#include "cache.h"
+#include "virtual_memory.h"
+#include "policies/policy.h"
+
+static void add_entry(workload* wl, int arrival, const char* program, int priority,
+                      int relative_deadline, int period) {
+    if (wl->count == wl->capacity) {
+        int capacity = wl->capacity ? wl->capacity * 2 : INITIAL_PROCESS_CAPACITY;
+        workload_entry* entries = realloc(wl->entries, capacity * sizeof(workload_entry));
+        if (!entries) {
+            printf("[Workload] Aviso: sem memória para o trace, ignorando %s\n", program);
+            return;
+        }
+        wl->entries = entries;
+        wl->capacity = capacity;
+    }
+
+    // Inserção ordenada e estável por ciclo de chegada
+    int i = wl->count++;
+    while (i > 0 && wl->entries[i - 1].arrival_cycle > arrival) {
+        wl->entries[i] = wl->entries[i - 1];
+        i--;
+    }
+
+    wl->entries[i].arrival_cycle = arrival;
+    snprintf(wl->entries[i].program, MAX_PROGRAM_NAME, "%s", program);
+    wl->entries[i].priority = priority > 0 ? priority : 1;
+    wl->entries[i].relative_deadline = relative_deadline > 0 ? relative_deadline : 0;
+    wl->entries[i].period = period > 0 ? period : 0;
+}
+
+// Formato CSV: ciclo,programa,prioridade[,prazo,período] (linhas com # são
+// comentários). Prazo e período em ciclos, usados pelo EDF.
+bool load_workload(workload* wl, const char* filename) {
+    if (!wl || !filename) return false;
+
+    wl->entries = NULL;
+    wl->count = 0;
+    wl->capacity = 0;
+    wl->next = 0;
+
+    FILE* arq = fopen(filename, "r");
+    if (!arq) return false;
+
+    char line[256];
+    int line_number = 0;
+    while (fgets(line, sizeof(line), arq)) {
+        line_number++;
+
+        char* start = line;
+        while (*start == ' ' || *start == '\t') start++;
+        if (*start == '#' || *start == '\n' || *start == '\0') continue;
+
+        int arrival, priority = 1, relative_deadline = 0, period = 0;
+        char program[MAX_PROGRAM_NAME];
+        int fields = sscanf(start, "%d , %99[^,\n] , %d , %d , %d", &arrival, program,
+                            &priority, &relative_deadline, &period);
+        if (fields < 2 || arrival < 0) {
+            printf("[Workload] Aviso: linha %d inválida em %s\n", line_number, filename);
+            continue;
+        }
+
+        trim(program);
+        add_entry(wl, arrival, program, priority, relative_deadline, period);
+    }
+
+    fclose(arq);
+    return wl->count > 0;
+}
+
+// Carga fechada original: os três programas chegam no ciclo 0
+void default_workload(workload* wl) {
+    if (!wl) return;
+
+    free_workload(wl);
+    add_entry(wl, 0, "program.txt", 1, 0, 0);
+    add_entry(wl, 0, "program2.txt", 1, 0, 0);
+    add_entry(wl, 0, "program3.txt", 1, 0, 0);
+}
+
+typedef enum {
+    ADMIT_OK,
+    ADMIT_SKIP,   // Entrada inválida: descartada
+    ADMIT_RETRY   // Sem RAM livre: tenta de novo no próximo ciclo
+} admit_result;
+
+static admit_result admit_process(cpu* cpu, const workload_entry* entry, int cycle) {
+    char filename[MAX_PROGRAM_NAME + 16];
+    snprintf(filename, sizeof(filename), "dataset/%s", entry->program);
+
+    char* program = read_program(filename);
+    if (!program) return ADMIT_SKIP;
+
+    // Região do tamanho exato do programa (+ terminador)
+    unsigned int size = strlen(program) + 1;
+    if (size > cpu->memory_ram->size) {
+        printf("\n[Workload] %s não cabe na RAM (%u bytes)", entry->program, size);
+        free(program);
+        return ADMIT_SKIP;
+    }
+
+    pthread_mutex_lock(&cpu->memory_ram->mutex);
+    int base_address = ram_alloc(cpu->memory_ram, size);
+    pthread_mutex_unlock(&cpu->memory_ram->mutex);
+
+    if (base_address < 0) {
+        free(program);
+        return ADMIT_RETRY;
+    }
+
+    PCB* process = create_pcb();
+    if (!process) {
+        pthread_mutex_lock(&cpu->memory_ram->mutex);
+        ram_free(cpu->memory_ram, base_address, size);
+        pthread_mutex_unlock(&cpu->memory_ram->mutex);
+        free(program);
+        return ADMIT_SKIP;
+    }
+
+    process->base_address = base_address;
+    process->memory_limit = base_address + size - 1;
+    process->cold->arrival_time = cycle;
+    process->last_scheduled = cycle;
+    process->cold->priority = entry->priority;
+    edf_set_deadline(process, entry->relative_deadline, entry->period);
+
+    load_program_on_ram(cpu, program, base_address, process);
+    cache_invalidate_range(base_address, size);
+    cache_track_region(process->pid, process->base_address, process->memory_limit);
+    free(program);
+
+    // Inserção na fila de prontos com a simulação em andamento
+    lock_process_manager(cpu->process_manager);
+    lottery_set_tickets(cpu->process_manager, process, LOTTERY_DEFAULT_TICKETS * entry->priority);
+    process->state = READY;
+    enqueue_ready_process(cpu->process_manager, process);
+    unlock_process_manager(cpu->process_manager);
+
+    // Recusado pelo controle de admissão (EDF): não vai rodar, então a
+    // região do programa e o espaço de endereçamento voltam já
+    if (process->state == FINISHED) {
+        pthread_mutex_lock(&cpu->memory_ram->mutex);
+        ram_free(cpu->memory_ram, base_address, size);
+        release_address_space(cpu->memory_ram, process);
+        pthread_mutex_unlock(&cpu->memory_ram->mutex);
+        retire_pcb(process);
+        return ADMIT_SKIP;
+    }
+
+    show_process_state(process->pid, "CREATED", "READY");
+    printf("\n[Workload] P%d (%s) chegou no ciclo %d, prioridade %d (RAM %d-%d)",
+           process->pid, entry->program, cycle, entry->priority,
+           base_address, process->memory_limit);
+    return ADMIT_OK;
+}
+
+// Admite todas as entradas cuja chegada já ocorreu; sem RAM livre, a fila
+// de chegada espera (em ordem) até algum processo terminar
+int admit_arrivals(cpu* cpu, workload* wl, int cycle) {
+    if (!cpu || !cpu->process_manager || !wl) return 0;
+
+    int admitted = 0;
+    while (wl->next < wl->count && wl->entries[wl->next].arrival_cycle <= cycle) {
+        admit_result result = admit_process(cpu, &wl->entries[wl->next], cycle);
+        if (result == ADMIT_RETRY) break;
+        if (result == ADMIT_OK) admitted++;
+        wl->next++;
+    }
+    return admitted;
+}
+
+bool workload_pending(const workload* wl) {
+    return wl && wl->next < wl->count;
+}
+
+void free_workload(workload* wl) {
+    if (!wl) return;
+
+    free(wl->entries);
+    wl->entries = NULL;
+    wl->count = 0;
+    wl->capacity = 0;
+    wl->next = 0;
+}
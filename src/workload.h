@@ -0,0 +1,37 @@
+#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "libs.h"
+#include "cpu.h"
+
+#ifndef WORKLOAD_FILE
+#define WORKLOAD_FILE "dataset/workload.csv"
+#endif
+#define MAX_PROGRAM_NAME 100
+
+// Uma linha do trace: ciclo de chegada, arquivo do programa, prioridade e,
+// opcionalmente, prazo relativo e período (EDF; 0 = não informado)
+typedef struct workload_entry {
+    int arrival_cycle;
+    char program[MAX_PROGRAM_NAME];
+    int priority;
+    int relative_deadline;
+    int period;
+} workload_entry;
+
+// Trace ordenado por chegada; next aponta para a próxima admissão
+typedef struct workload {
+    workload_entry* entries;
+    int count;
+    int capacity;
+    int next;
+} workload;
+
+// Funções do trace de carga
+bool load_workload(workload* wl, const char* filename);
+void default_workload(workload* wl);
+int admit_arrivals(cpu* cpu, workload* wl, int cycle);
+bool workload_pending(const workload* wl);
+void free_workload(workload* wl);
+
+#endif
@@ -0,0 +1,114 @@
+#include "write_buffer.h"
+#include "cache_hierarchy.h"
+#include <stdio.h>
+#include <string.h>
+
+static write_buffer_entry buffers[NUM_CORES][WRITE_BUFFER_ENTRIES];
+static unsigned long arrival_clock = 0;
+static int retire_countdown = WRITE_BUFFER_RETIRE_CYCLES;
+
+static int buffered_stores = 0;
+static int combined_stores = 0;   // Juntados a uma entrada já pendente
+static int full_stalls = 0;       // Buffer cheio: core espera a drenagem
+static int timed_retires = 0;     // Aposentadas em segundo plano
+static int memory_writes = 0;
+static int memory_bytes = 0;
+
+void reset_write_buffers(void) {
+    memset(buffers, 0, sizeof(buffers));
+    arrival_clock = 0;
+    retire_countdown = WRITE_BUFFER_RETIRE_CYCLES;
+    buffered_stores = combined_stores = full_stalls = timed_retires = 0;
+    memory_writes = memory_bytes = 0;
+}
+
+static void drain_entry(write_buffer_entry* entry) {
+    memory_writes++;
+    memory_bytes += __builtin_popcount(entry->mask);
+    entry->valid = false;
+}
+
+// Os dados já estão na RAM (o simulador escreve na hora); o buffer só conta
+// as transações. Devolve os ciclos de stall (buffer cheio).
+int write_buffer_put(int core_id, unsigned int address, int length) {
+    write_buffer_entry* entries = buffers[core_id];
+    unsigned int block = address / BLOCK_SIZE;
+    uint32_t mask = CACHE_BYTE_MASK(CACHE_OFFSET(address), length);
+    buffered_stores++;
+
+    write_buffer_entry* free_entry = NULL;
+    write_buffer_entry* oldest = NULL;
+    for (int i = 0; i < WRITE_BUFFER_ENTRIES; i++) {
+        if (!entries[i].valid) {
+            if (!free_entry) free_entry = &entries[i];
+            continue;
+        }
+        if (entries[i].block == block) {
+            entries[i].mask |= mask;
+            combined_stores++;
+            return 0;
+        }
+        if (!oldest || entries[i].stamp < oldest->stamp) oldest = &entries[i];
+    }
+
+    int latency = 0;
+    if (!free_entry) {
+        drain_entry(oldest);
+        free_entry = oldest;
+        full_stalls++;
+        latency = MEMORY_LATENCY;
+    }
+
+    free_entry->block = block;
+    free_entry->mask = mask;
+    free_entry->stamp = ++arrival_clock;
+    free_entry->valid = true;
+    return latency;
+}
+
+// Um ciclo do simulador: a cada WRITE_BUFFER_RETIRE_CYCLES a memória
+// aceita a entrada mais antiga de cada core, sem atrasá-lo
+void write_buffer_tick(void) {
+    if (--retire_countdown > 0) return;
+    retire_countdown = WRITE_BUFFER_RETIRE_CYCLES;
+
+    for (int core = 0; core < NUM_CORES; core++) {
+        write_buffer_entry* oldest = NULL;
+        for (int i = 0; i < WRITE_BUFFER_ENTRIES; i++) {
+            write_buffer_entry* entry = &buffers[core][i];
+            if (entry->valid && (!oldest || entry->stamp < oldest->stamp)) oldest = entry;
+        }
+        if (oldest) {
+            drain_entry(oldest);
+            timed_retires++;
+        }
+    }
+}
+
+// Fim da execução: tudo que estava pendente vai para a memória
+void write_buffer_drain(void) {
+    for (int core = 0; core < NUM_CORES; core++) {
+        for (int i = 0; i < WRITE_BUFFER_ENTRIES; i++) {
+            if (buffers[core][i].valid) drain_entry(&buffers[core][i]);
+        }
+    }
+}
+
+int write_buffer_memory_writes(void) {
+    return memory_writes;
+}
+
+int write_buffer_memory_bytes(void) {
+    return memory_bytes;
+}
+
+void print_write_buffer_statistics(void) {
+    if (buffered_stores == 0) return;
+    printf("\n║ Buffer de escrita: %d entradas por core", WRITE_BUFFER_ENTRIES);
+    printf("\n║ ├── STOREs no buffer: %d (combinados: %d, %.1f%%)",
+           buffered_stores, combined_stores,
+           (float)combined_stores * 100 / buffered_stores);
+    printf("\n║ ├── Escritas na memória: %d (%d bytes)", memory_writes, memory_bytes);
+    printf("\n║ ├── Aposentadas a cada %d ciclos: %d", WRITE_BUFFER_RETIRE_CYCLES, timed_retires);
+    printf("\n║ └── Stalls por buffer cheio: %d", full_stalls);
+}
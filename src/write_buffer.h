@@ -0,0 +1,33 @@
+#ifndef WRITE_BUFFER_H
+#define WRITE_BUFFER_H
+
+#include "cache.h"
+
+// Buffer de escrita com combinação, um por core: STOREs para um bloco que
+// já tem entrada pendente se juntam a ela e saem como uma única escrita na
+// memória. Buffer cheio drena a entrada mais antiga e atrasa o core; sem
+// isso, cada core aposenta a mais antiga a cada WRITE_BUFFER_RETIRE_CYCLES
+// ciclos, e só combina quem chega antes da saída.
+#ifndef WRITE_BUFFER_ENTRIES
+#define WRITE_BUFFER_ENTRIES 4
+#endif
+#ifndef WRITE_BUFFER_RETIRE_CYCLES
+#define WRITE_BUFFER_RETIRE_CYCLES 8
+#endif
+
+typedef struct {
+    unsigned int block;
+    uint32_t mask;          // Bytes do bloco com escrita pendente
+    unsigned long stamp;    // Ordem de chegada (drena o mais antigo)
+    bool valid;
+} write_buffer_entry;
+
+void reset_write_buffers(void);
+int write_buffer_put(int core_id, unsigned int address, int length);
+void write_buffer_tick(void);
+void write_buffer_drain(void);
+int write_buffer_memory_writes(void);
+int write_buffer_memory_bytes(void);
+void print_write_buffer_statistics(void);
+
+#endif